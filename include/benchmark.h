@@ -0,0 +1,8 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// Shared helpers for the benchmark functions of every data structure
+double benchmark_now_seconds();
+void benchmark_report(const char *name, int operations, double seconds);
+
+#endif
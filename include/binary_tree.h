@@ -19,7 +19,21 @@ BinaryTreeNode *create_binary_tree_node();
 int insert_binary_tree_node(BinaryTreeNode **head, int data);
 void print_binary_tree_inorder_route(BinaryTreeNode *head);
 BinaryTreeNode * delete_binary_tree_node(BinaryTreeNode *head, int data);
+int remove_binary_tree_node(BinaryTreeNode **head, int data);
 BinaryTreeNode *search_binary_tree_node(BinaryTreeNode *head, int data);
+BinaryTreeNode *find_binary_tree_node(BinaryTreeNode *node, int data);
+BinaryTreeNode *find_binary_tree_max_node(BinaryTreeNode *node);
+int free_binary_tree(BinaryTreeNode **head);
+
+// Set operations
+BinaryTreeNode *union_binary_tree(BinaryTreeNode *first, BinaryTreeNode *second);
+BinaryTreeNode *intersection_binary_tree(BinaryTreeNode *first, BinaryTreeNode *second);
+BinaryTreeNode *difference_binary_tree(BinaryTreeNode *first, BinaryTreeNode *second);
+
+// Auxiliar functions
+int count_binary_tree_nodes(BinaryTreeNode *head);
+int binary_tree_to_sorted_array(BinaryTreeNode *head, int *array, int size);
+BinaryTreeNode *build_binary_tree_from_sorted_array(const int *array, int size);
 
 // Test function
 void test_binary_tree();
@@ -0,0 +1,46 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "binary_tree.h"
+
+// 512 bits: every block fills one cache line
+#define BLOOM_FILTER_BLOCK_WORDS 8
+
+// Blocked Bloom filter: all the bits of a key live in the same block, so a query costs a
+// single cache miss. stale_keys counts deleted keys whose bits are still set
+typedef struct BloomFilter
+{
+  uint64_t *blocks;
+  uint32_t blocks_count;
+  int hashes;
+  int keys;
+  int stale_keys;
+} BloomFilter;
+
+// Main functions
+BloomFilter *create_bloom_filter(int expected_keys, int bits_per_key);
+int free_bloom_filter(BloomFilter **filter);
+int add_bloom_filter(BloomFilter *filter, int key);
+int may_contain_bloom_filter(const BloomFilter *filter, int key);
+void clear_bloom_filter(BloomFilter *filter);
+double bloom_filter_false_positive_rate(const BloomFilter *filter);
+size_t bloom_filter_memory_usage(const BloomFilter *filter);
+
+// Binary tree functions. The filter isn't stored in the tree: the caller keeps both and
+// must change the tree only through these wrappers. A value added with a plain
+// insert_binary_tree_node is missing from the filter, so the filtered find reports it as
+// absent (a false negative) until rebuild_bloom_filter is called
+int insert_filtered_binary_tree_node(BinaryTreeNode **head, BloomFilter *filter, int data);
+BinaryTreeNode *find_filtered_binary_tree_node(BinaryTreeNode *head, const BloomFilter *filter, int data);
+BinaryTreeNode *delete_filtered_binary_tree_node(BinaryTreeNode *head, BloomFilter *filter, int data);
+int rebuild_bloom_filter(BloomFilter *filter, BinaryTreeNode *head);
+
+// Test functions
+void test_bloom_filter();
+
+// Benchmark functions
+void benchmark_bloom_filter();
+
+#endif
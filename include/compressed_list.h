@@ -0,0 +1,66 @@
+#ifndef COMPRESSED_LIST_H
+#define COMPRESSED_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Amount of values stored in every compressed block
+#define COMPRESSED_LIST_BLOCK_SIZE 128
+
+// Skip header of a block. The first value is stored as is, the other values are stored as
+// the difference with the previous one, packed with bit_width bits each into four
+// interleaved lanes starting at offset
+typedef struct CompressedListBlock
+{
+  int first;
+  int last;
+  uint32_t offset;
+  uint8_t bit_width;
+  uint8_t count;
+} CompressedListBlock;
+
+// Append-only sorted sequence of ints. Values that don't fill a block yet wait in pending
+typedef struct CompressedList
+{
+  CompressedListBlock *blocks;
+  int blocks_count;
+  int blocks_capacity;
+  uint32_t *words;
+  uint32_t words_count;
+  uint32_t words_capacity;
+  int pending[COMPRESSED_LIST_BLOCK_SIZE];
+  int pending_count;
+  int size;
+} CompressedList;
+
+// Sequential reader. Blocks are decoded one at a time into values
+typedef struct CompressedListIterator
+{
+  const CompressedList *list;
+  int block;
+  int position;
+  int count;
+  int values[COMPRESSED_LIST_BLOCK_SIZE];
+} CompressedListIterator;
+
+// Main functions
+CompressedList *create_compressed_list();
+int free_compressed_list(CompressedList **list);
+int append_compressed_list(CompressedList *list, int data);
+int compressed_list_to_array(const CompressedList *list, int *array, int size);
+size_t compressed_list_memory_usage(const CompressedList *list);
+
+// Iteration functions
+void init_compressed_list_iterator(CompressedListIterator *iterator, const CompressedList *list);
+int next_compressed_list_iterator(CompressedListIterator *iterator, int *data);
+int next_block_compressed_list_iterator(CompressedListIterator *iterator, const int **values);
+int next_geq_compressed_list_iterator(CompressedListIterator *iterator, int target, int *data);
+int intersect_compressed_lists(const CompressedList *first, const CompressedList *second, int *result, int size);
+
+// Test functions
+void test_compressed_list();
+
+// Benchmark functions
+void benchmark_compressed_list();
+
+#endif
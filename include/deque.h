@@ -0,0 +1,54 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdalign.h>
+#include <stdatomic.h>
+
+// Growable circular buffer of ints. Capacity is always a power of two so positions are
+// wrapped with a mask
+typedef struct Deque
+{
+  int *data;
+  int capacity;
+  int head;
+  int size;
+} Deque;
+
+// Fixed capacity circular buffer shared by exactly one producer thread and one consumer
+// thread. head is only written by the consumer and tail only by the producer, each one on
+// its own cache line
+typedef struct SpscQueue
+{
+  int *data;
+  unsigned int capacity;
+  alignas(64) atomic_uint head;
+  alignas(64) atomic_uint tail;
+} SpscQueue;
+
+// Main functions
+Deque *create_deque(int capacity);
+int free_deque(Deque **deque);
+int push_back_deque(Deque *deque, int data);
+int push_front_deque(Deque *deque, int data);
+int pop_back_deque(Deque *deque, int *data);
+int pop_front_deque(Deque *deque, int *data);
+int peek_back_deque(Deque *deque, int *data);
+int peek_front_deque(Deque *deque, int *data);
+
+// Bulk functions
+int enqueue_deque(Deque *deque, const int *values, int count);
+int dequeue_deque(Deque *deque, int *values, int count);
+
+// Single producer / single consumer functions
+SpscQueue *create_spsc_queue(int capacity);
+int free_spsc_queue(SpscQueue **queue);
+int enqueue_spsc_queue(SpscQueue *queue, const int *values, int count);
+int dequeue_spsc_queue(SpscQueue *queue, int *values, int count);
+
+// Test functions
+void test_deque();
+
+// Benchmark functions
+void benchmark_deque();
+
+#endif
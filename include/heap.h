@@ -0,0 +1,54 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+// Arity used when none is given: the four children of a node share a cache line
+#define HEAP_DEFAULT_ARITY 4
+
+typedef enum HeapOrder
+{
+  MIN_HEAP,
+  MAX_HEAP
+} HeapOrder;
+
+typedef struct HeapEntry
+{
+  int data;
+  int handle;
+} HeapEntry;
+
+// Array based d-ary heap. Every element gets a handle when it's pushed, positions maps a
+// handle to the index of its entry (or -1 when the element isn't in the heap anymore)
+typedef struct Heap
+{
+  HeapEntry *entries;
+  int size;
+  int capacity;
+  int arity;
+  HeapOrder order;
+  int *positions;
+  int handles_count;
+  int handles_capacity;
+  int *free_handles;
+  int free_handles_size;
+} Heap;
+
+// Main functions
+Heap *create_heap(HeapOrder order, int arity);
+Heap *heapify_array(const int *values, int count, HeapOrder order, int arity);
+int free_heap(Heap **heap);
+int push_heap(Heap *heap, int data);
+int pop_heap(Heap *heap, int *data);
+int peek_heap(Heap *heap, int *data);
+int update_heap_key(Heap *heap, int handle, int data);
+
+// Top-k functions
+int offer_heap_top_k(Heap *heap, int k, int data);
+int select_top_k(const int *values, int count, int k, int *result);
+
+// Test functions
+void test_heap();
+
+// Benchmark functions
+void benchmark_heap();
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef LAZY_BINARY_TREE_H
+#define LAZY_BINARY_TREE_H
+
+// Smallest subtree that a delete compacts by itself. Smaller ones keep their tombstones until
+// a bigger subtree above them is compacted, so a delete rarely does more than mark a node
+#define LAZY_BINARY_TREE_MIN_REBUILD 64
+
+// Largest subtree that a delete compacts by itself, so a delete never costs more than
+// twice the height of the tree plus this amount of nodes
+#define LAZY_BINARY_TREE_MAX_REBUILD 1024
+
+// Node of a binary tree where deletes only leave a tombstone. Every node counts the nodes
+// of its subtree, dead ones included, and how many of them are dead
+typedef struct LazyBinaryTreeNode
+{
+  int data;
+  unsigned char deleted;
+  int nodes;
+  int dead_nodes;
+  struct LazyBinaryTreeNode *left;
+  struct LazyBinaryTreeNode *right;
+} LazyBinaryTreeNode;
+
+// Equal values go to the right side like in binary_tree.h. Once the dead nodes of a subtree
+// on the path of a delete reach the compaction threshold, and the subtree is within the
+// rebuild sizes, that subtree is rebuilt balanced without them
+typedef struct LazyBinaryTree
+{
+  LazyBinaryTreeNode *head;
+  double compaction_threshold;
+} LazyBinaryTree;
+
+// Main functions
+void init_lazy_binary_tree(LazyBinaryTree *tree, double compaction_threshold);
+int insert_lazy_binary_tree_node(LazyBinaryTree *tree, int data);
+int delete_lazy_binary_tree_node(LazyBinaryTree *tree, int data);
+LazyBinaryTreeNode *find_lazy_binary_tree_node(LazyBinaryTree *tree, int data);
+int free_lazy_binary_tree(LazyBinaryTree *tree);
+
+// Compaction functions
+int count_lazy_binary_tree_live_nodes(const LazyBinaryTree *tree);
+int count_lazy_binary_tree_dead_nodes(const LazyBinaryTree *tree);
+double lazy_binary_tree_dead_ratio(const LazyBinaryTree *tree);
+int compact_lazy_binary_tree(LazyBinaryTree *tree);
+
+// Auxiliar functions
+int lazy_binary_tree_to_sorted_array(LazyBinaryTree *tree, int *array, int size);
+
+// Test function
+void test_lazy_binary_tree();
+
+#endif
@@ -14,9 +14,22 @@ int pop_linked_list(LinkedListNode **head);
 int shift_linked_list(LinkedListNode **head);
 int push_linked_list(LinkedListNode **head, int data);
 int append_linked_list(LinkedListNode **head, int data);
+LinkedListNode *build_linked_list_from_array(const int *array, int size);
 int free_linked_list(LinkedListNode **head);
 void print_linked_list(LinkedListNode *head);
 
+// Set operations (given lists must be sorted)
+LinkedListNode *union_linked_list(LinkedListNode *first, LinkedListNode *second);
+LinkedListNode *intersection_linked_list(LinkedListNode *first, LinkedListNode *second);
+LinkedListNode *difference_linked_list(LinkedListNode *first, LinkedListNode *second);
+
+// Relinking operations
+int reverse_linked_list(LinkedListNode **head);
+LinkedListNode *split_linked_list(LinkedListNode **head, int index);
+int concat_linked_list(LinkedListNode **head, LinkedListNode *last_node, LinkedListNode *other);
+int sort_linked_list(LinkedListNode **head);
+LinkedListNode *merge_sorted_linked_lists(LinkedListNode **lists, int count);
+
 // Auxiliar functions
 LinkedListNode *take_last_from_linked_list(LinkedListNode *head);
 LinkedListNode *take_penultimate_from_linked_list(LinkedListNode *head);
@@ -24,4 +37,7 @@ LinkedListNode *take_penultimate_from_linked_list(LinkedListNode *head);
 // Test functions
 void test_linked_list();
 
+// Benchmark functions
+void benchmark_linked_list();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stddef.h>
+#include "linked_list.h"
+#include "binary_tree.h"
+
+// Layout of the loaded input: decimal ints separated by anything that isn't a digit or a
+// minus sign, or raw little-endian int32
+typedef enum LoaderFormat
+{
+  LOADER_TEXT,
+  LOADER_BINARY
+} LoaderFormat;
+
+// Main functions
+int *load_keys(const char *path, LoaderFormat format, int *count);
+LinkedListNode *load_linked_list(const char *path, LoaderFormat format, int *count);
+BinaryTreeNode *load_binary_tree(const char *path, LoaderFormat format, int *count);
+
+// Parsing functions
+int parse_decimal_keys(const char *buffer, size_t length, int *keys, int capacity);
+int decode_binary_keys(const unsigned char *buffer, size_t length, int *keys, int capacity);
+
+// Auxiliar functions
+int sort_keys(int *keys, int count);
+int run_loader_command(int argc, char **argv);
+
+// Test functions
+void test_loader();
+
+#endif
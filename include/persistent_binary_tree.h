@@ -0,0 +1,47 @@
+#ifndef PERSISTENT_BINARY_TREE_H
+#define PERSISTENT_BINARY_TREE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Node of an immutable binary search tree. Nodes are shared between versions, so they must
+// never be modified once they are reachable from a root
+typedef struct PersistentBinaryTreeNode
+{
+  int data;
+  atomic_int references;
+  struct PersistentBinaryTreeNode *left;
+  struct PersistentBinaryTreeNode *right;
+} PersistentBinaryTreeNode;
+
+// Amount of readers that can be retaining the current root at the same time
+#define PERSISTENT_BINARY_TREE_HAZARDS 64
+
+// Holder for the latest version of a persistent tree. Writers are serialized by write_lock.
+// Readers never lock: they announce the root they are about to retain in a hazard slot, and
+// a writer doesn't release a replaced root while a slot still announces it
+typedef struct PersistentBinaryTree
+{
+  _Atomic(PersistentBinaryTreeNode *) root;
+  _Atomic(PersistentBinaryTreeNode *) hazards[PERSISTENT_BINARY_TREE_HAZARDS];
+  pthread_mutex_t write_lock;
+} PersistentBinaryTree;
+
+// Main functions
+int insert_persistent_binary_tree_node(PersistentBinaryTreeNode *root, int data, PersistentBinaryTreeNode **version);
+int delete_persistent_binary_tree_node(PersistentBinaryTreeNode *root, int data, PersistentBinaryTreeNode **version);
+PersistentBinaryTreeNode *search_persistent_binary_tree_node(PersistentBinaryTreeNode *root, int data);
+PersistentBinaryTreeNode *retain_persistent_binary_tree(PersistentBinaryTreeNode *root);
+int release_persistent_binary_tree(PersistentBinaryTreeNode *root);
+
+// Shared version functions
+int init_persistent_binary_tree(PersistentBinaryTree *tree);
+void destroy_persistent_binary_tree(PersistentBinaryTree *tree);
+PersistentBinaryTreeNode *snapshot_persistent_binary_tree(PersistentBinaryTree *tree);
+int insert_persistent_binary_tree(PersistentBinaryTree *tree, int data);
+int delete_persistent_binary_tree(PersistentBinaryTree *tree, int data);
+
+// Test function
+void test_persistent_binary_tree();
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef RADIX_TREE_H
+#define RADIX_TREE_H
+
+// Inner nodes are defined in radix_tree.c. Leaves aren't allocated: a leaf is a tagged
+// pointer that carries the key itself
+typedef struct RadixTreeNode RadixTreeNode;
+
+// Adaptive radix tree of ints. Every level consumes one byte of the key, so a lookup visits
+// at most 4 nodes no matter how many keys the tree has
+typedef struct RadixTree
+{
+  RadixTreeNode *root;
+  int size;
+} RadixTree;
+
+// Ordered iteration state: one frame per level plus the leaf
+typedef struct RadixTreeIterator
+{
+  RadixTreeNode *nodes[5];
+  int positions[5];
+  int depth;
+} RadixTreeIterator;
+
+// Main functions
+RadixTree *create_radix_tree();
+int free_radix_tree(RadixTree **tree);
+int insert_radix_tree(RadixTree *tree, int key);
+int search_radix_tree(RadixTree *tree, int key);
+int delete_radix_tree(RadixTree *tree, int key);
+
+// Iteration functions
+void init_radix_tree_iterator(RadixTreeIterator *iterator, RadixTree *tree);
+int next_radix_tree_iterator(RadixTreeIterator *iterator, int *key);
+int radix_tree_to_sorted_array(RadixTree *tree, int *array, int size);
+
+// Test functions
+void test_radix_tree();
+
+// Benchmark functions
+void benchmark_radix_tree();
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef TREAP_H
+#define TREAP_H
+
+// Binary search tree that is also a max-heap by priority. Every node gets its own pseudo
+// random priority, so the expected height is O(log n) for any insertion order, repeated
+// values included
+typedef struct TreapNode
+{
+  int data;
+  unsigned int priority;
+  struct TreapNode *left;
+  struct TreapNode *right;
+} TreapNode;
+
+// Main functions
+TreapNode *create_treap_node(int data);
+int insert_treap_node(TreapNode **root, int data);
+int delete_treap_node(TreapNode **root, int data);
+TreapNode *search_treap_node(TreapNode *root, int data);
+int free_treap(TreapNode **root);
+
+// Partitioning functions
+void split_treap(TreapNode *root, int key, TreapNode **left, TreapNode **right);
+TreapNode *join_treap(TreapNode *left, TreapNode *right);
+
+// Bulk functions
+int bulk_insert_treap(TreapNode **root, const int *values, int count, int threads);
+int bulk_delete_treap(TreapNode **root, const int *values, int count, int threads);
+
+// Test functions
+void test_treap();
+
+#endif
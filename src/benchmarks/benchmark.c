@@ -0,0 +1,37 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "benchmark.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief reads a monotonic clock
+ *
+ * @returns current time in seconds
+ *
+ * Only the difference between two calls is meaningful
+ */
+double benchmark_now_seconds()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief prints the result of a benchmark
+ *
+ * @param name Description of the measured operation
+ * @param operations Amount of elements processed
+ * @param seconds Elapsed time
+ *
+ * The line shows the total time and the time per element in nanoseconds
+ */
+void benchmark_report(const char *name, int operations, double seconds)
+{
+  double nanoseconds = (operations > 0) ? seconds * 1e9 / operations : 0.0;
+
+  printf("  %-48s %10d ops %10.3f ms %8.1f ns/op\n", name, operations, seconds * 1e3, nanoseconds);
+}
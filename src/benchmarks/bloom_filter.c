@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+#include "binary_tree.h"
+#include "bloom_filter.h"
+
+void benchmark_bloom_filter()
+{
+  int count = 1000000;
+  BinaryTreeNode *head = NULL;
+  BloomFilter *filter = create_bloom_filter(count, 10);
+
+  printf("Bloom filter benchmarks\n");
+  printf(" %d keys, lookups of absent keys\n", count);
+
+  srand(37);
+  for (int i = 0; i < count; i++)
+  {
+    // Even keys are stored, odd keys are the absent ones
+    insert_filtered_binary_tree_node(&head, filter, (rand() % count) * 2);
+  }
+
+  printf("  filter memory %zu bytes, estimated false positive rate %.4f\n",
+         bloom_filter_memory_usage(filter), bloom_filter_false_positive_rate(filter));
+
+  int found = 0;
+  double start = benchmark_now_seconds();
+  for (int i = 0; i < count; i++)
+  {
+    found += find_binary_tree_node(head, (rand() % count) * 2 + 1) != NULL;
+  }
+  benchmark_report("find_binary_tree_node", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  for (int i = 0; i < count; i++)
+  {
+    found += find_filtered_binary_tree_node(head, filter, (rand() % count) * 2 + 1) != NULL;
+  }
+  benchmark_report("find_filtered_binary_tree_node", count, benchmark_now_seconds() - start);
+
+  if (found != 0)
+  {
+    printf("  absent keys were found!\n");
+  }
+
+  free_binary_tree(&head);
+  free_bloom_filter(&filter);
+  printf("\n");
+}
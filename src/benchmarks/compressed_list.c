@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+#include "compressed_list.h"
+#include "linked_list.h"
+
+// glibc rounds a 16 byte node up to a 32 byte chunk
+#define LINKED_LIST_NODE_FOOTPRINT 32
+
+static int *sorted_postings(int count, int average_gap)
+{
+  int *values = (int *)malloc(sizeof(int) * count);
+  int value = 0;
+
+  for (int i = 0; i < count; i++)
+  {
+    value += 1 + rand() % (2 * average_gap);
+    values[i] = value;
+  }
+
+  return values;
+}
+
+static LinkedListNode *build_linked_list(const int *values, int count)
+{
+  LinkedListNode *head = NULL;
+
+  // Prepending from the end keeps the list sorted without walking to the tail
+  for (int i = count - 1; i >= 0; i--)
+  {
+    append_linked_list(&head, values[i]);
+  }
+
+  return head;
+}
+
+static int intersect_linked_lists(LinkedListNode *first_node, LinkedListNode *second_node)
+{
+  int common_values = 0;
+
+  while (first_node != NULL && second_node != NULL)
+  {
+    if (first_node->data == second_node->data)
+    {
+      common_values++;
+      first_node = first_node->next;
+      second_node = second_node->next;
+    }
+    else if (first_node->data < second_node->data)
+    {
+      first_node = first_node->next;
+    }
+    else
+    {
+      second_node = second_node->next;
+    }
+  }
+
+  return common_values;
+}
+
+static void benchmark_postings(int count, int average_gap)
+{
+  printf(" %d sorted values with an average gap of %d\n", count, average_gap);
+
+  srand(29);
+  int *first_values = sorted_postings(count, average_gap);
+  int *second_values = sorted_postings(count, average_gap);
+  int *result = (int *)malloc(sizeof(int) * count);
+
+  LinkedListNode *first_list = build_linked_list(first_values, count);
+  LinkedListNode *second_list = build_linked_list(second_values, count);
+  CompressedList *first = create_compressed_list();
+  CompressedList *second = create_compressed_list();
+
+  for (int i = 0; i < count; i++)
+  {
+    append_compressed_list(first, first_values[i]);
+    append_compressed_list(second, second_values[i]);
+  }
+
+  size_t linked_list_bytes = (size_t)count * LINKED_LIST_NODE_FOOTPRINT;
+  size_t compressed_bytes = compressed_list_memory_usage(first);
+  printf("  memory: linked list %zu bytes, compressed list %zu bytes (%.1fx smaller)\n",
+         linked_list_bytes, compressed_bytes, (double)linked_list_bytes / compressed_bytes);
+
+  long long linked_list_sum = 0;
+  double start = benchmark_now_seconds();
+  for (LinkedListNode *node = first_list; node != NULL; node = node->next)
+  {
+    linked_list_sum += node->data;
+  }
+  benchmark_report("walk next pointers", count, benchmark_now_seconds() - start);
+
+  long long compressed_sum = 0;
+  int data = 0;
+  CompressedListIterator iterator;
+  start = benchmark_now_seconds();
+  init_compressed_list_iterator(&iterator, first);
+  while (next_compressed_list_iterator(&iterator, &data))
+  {
+    compressed_sum += data;
+  }
+  benchmark_report("next_compressed_list_iterator", count, benchmark_now_seconds() - start);
+
+  long long block_sum = 0;
+  const int *block_values = NULL;
+  int taken = 0;
+  start = benchmark_now_seconds();
+  init_compressed_list_iterator(&iterator, first);
+  while ((taken = next_block_compressed_list_iterator(&iterator, &block_values)) > 0)
+  {
+    for (int i = 0; i < taken; i++)
+    {
+      block_sum += block_values[i];
+    }
+  }
+  benchmark_report("next_block_compressed_list_iterator", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  compressed_list_to_array(first, result, count);
+  benchmark_report("compressed_list_to_array", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  int linked_list_common = intersect_linked_lists(first_list, second_list);
+  benchmark_report("intersect linked lists", 2 * count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  int compressed_common = intersect_compressed_lists(first, second, result, count);
+  benchmark_report("intersect_compressed_lists", 2 * count, benchmark_now_seconds() - start);
+
+  if (linked_list_sum != compressed_sum || linked_list_sum != block_sum || linked_list_common != compressed_common)
+  {
+    printf("  lists disagree!\n");
+  }
+
+  free(first_values);
+  free(second_values);
+  free(result);
+  free_linked_list(&first_list);
+  free_linked_list(&second_list);
+  free_compressed_list(&first);
+  free_compressed_list(&second);
+}
+
+// A short list against a long one: next_geq skips most blocks of the long list
+static void benchmark_skewed_intersection(int long_count, int short_count)
+{
+  printf(" intersection of %d and %d sorted values\n", long_count, short_count);
+
+  srand(31);
+  int *long_values = sorted_postings(long_count, 8);
+  int *short_values = sorted_postings(short_count, 8 * long_count / short_count);
+  int *result = (int *)malloc(sizeof(int) * short_count);
+
+  LinkedListNode *long_list = build_linked_list(long_values, long_count);
+  LinkedListNode *short_list = build_linked_list(short_values, short_count);
+  CompressedList *long_compressed = create_compressed_list();
+  CompressedList *short_compressed = create_compressed_list();
+
+  for (int i = 0; i < long_count; i++)
+  {
+    append_compressed_list(long_compressed, long_values[i]);
+  }
+  for (int i = 0; i < short_count; i++)
+  {
+    append_compressed_list(short_compressed, short_values[i]);
+  }
+
+  double start = benchmark_now_seconds();
+  int linked_list_common = intersect_linked_lists(short_list, long_list);
+  benchmark_report("intersect linked lists", short_count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  int compressed_common = intersect_compressed_lists(short_compressed, long_compressed, result, short_count);
+  benchmark_report("intersect_compressed_lists", short_count, benchmark_now_seconds() - start);
+
+  if (linked_list_common != compressed_common)
+  {
+    printf("  lists disagree!\n");
+  }
+
+  free(long_values);
+  free(short_values);
+  free(result);
+  free_linked_list(&long_list);
+  free_linked_list(&short_list);
+  free_compressed_list(&long_compressed);
+  free_compressed_list(&short_compressed);
+}
+
+void benchmark_compressed_list()
+{
+  printf("Compressed list benchmarks\n");
+  benchmark_postings(1000000, 8);
+  benchmark_postings(1000000, 1000);
+  benchmark_skewed_intersection(1000000, 1000);
+  printf("\n");
+}
@@ -0,0 +1,175 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "benchmark.h"
+#include "deque.h"
+#include "linked_list.h"
+
+static void benchmark_fifo(int size)
+{
+  printf(" FIFO with %d elements\n", size);
+
+  Deque *deque = create_deque(0);
+  int data = 0;
+  double start = benchmark_now_seconds();
+  for (int i = 0; i < size; i++)
+  {
+    push_back_deque(deque, i);
+  }
+  while (pop_front_deque(deque, &data) == 1)
+  {
+  }
+  benchmark_report("push_back_deque + pop_front_deque", size, benchmark_now_seconds() - start);
+  free_deque(&deque);
+
+  // push_linked_list walks to the tail on every call
+  LinkedListNode *head = NULL;
+  start = benchmark_now_seconds();
+  for (int i = 0; i < size; i++)
+  {
+    push_linked_list(&head, i);
+  }
+  while (shift_linked_list(&head) == 1)
+  {
+  }
+  benchmark_report("push_linked_list + shift_linked_list", size, benchmark_now_seconds() - start);
+}
+
+static void benchmark_lifo(int size)
+{
+  printf(" LIFO with %d elements\n", size);
+
+  LinkedListNode *head = NULL;
+  double start = benchmark_now_seconds();
+  for (int i = 0; i < size; i++)
+  {
+    append_linked_list(&head, i);
+  }
+  while (shift_linked_list(&head) == 1)
+  {
+  }
+  benchmark_report("append_linked_list + shift_linked_list", size, benchmark_now_seconds() - start);
+
+  Deque *deque = create_deque(0);
+  int data = 0;
+  start = benchmark_now_seconds();
+  for (int i = 0; i < size; i++)
+  {
+    push_back_deque(deque, i);
+  }
+  while (pop_back_deque(deque, &data) == 1)
+  {
+  }
+  benchmark_report("push_back_deque + pop_back_deque", size, benchmark_now_seconds() - start);
+
+  int *values = (int *)malloc(sizeof(int) * size);
+  for (int i = 0; i < size; i++)
+  {
+    values[i] = i;
+  }
+  start = benchmark_now_seconds();
+  for (int i = 0; i < size; i += 1024)
+  {
+    enqueue_deque(deque, values + i, (size - i < 1024) ? size - i : 1024);
+  }
+  while (dequeue_deque(deque, values, 1024) > 0)
+  {
+  }
+  benchmark_report("enqueue_deque + dequeue_deque (1024 per call)", size, benchmark_now_seconds() - start);
+
+  free(values);
+  free_deque(&deque);
+}
+
+typedef struct SpscBenchmark
+{
+  SpscQueue *queue;
+  int size;
+} SpscBenchmark;
+
+static void *spsc_benchmark_producer(void *argument)
+{
+  SpscBenchmark *benchmark = (SpscBenchmark *)argument;
+  int values[256];
+  int next = 0;
+
+  while (next < benchmark->size)
+  {
+    int count = (benchmark->size - next < 256) ? benchmark->size - next : 256;
+    for (int i = 0; i < count; i++)
+    {
+      values[i] = next + i;
+    }
+
+    int added = 0;
+    while (added < count)
+    {
+      int enqueued = enqueue_spsc_queue(benchmark->queue, values + added, count - added);
+      added += enqueued;
+
+      // Gives the consumer a chance to run when the queue is full
+      if (enqueued == 0)
+      {
+        sched_yield();
+      }
+    }
+    next += count;
+  }
+
+  return NULL;
+}
+
+static void benchmark_spsc(int size)
+{
+  printf(" Cross-thread pipeline with %d elements\n", size);
+
+  SpscBenchmark benchmark = {create_spsc_queue(4096), size};
+  int values[256];
+  long long sum = 0;
+  int received = 0;
+
+  double start = benchmark_now_seconds();
+  pthread_t producer;
+  pthread_create(&producer, NULL, spsc_benchmark_producer, &benchmark);
+
+  while (received < size)
+  {
+    int removed = dequeue_spsc_queue(benchmark.queue, values, 256);
+    for (int i = 0; i < removed; i++)
+    {
+      sum += values[i];
+    }
+    received += removed;
+
+    if (removed == 0)
+    {
+      sched_yield();
+    }
+  }
+
+  pthread_join(producer, NULL);
+  benchmark_report("enqueue_spsc_queue -> dequeue_spsc_queue", size, benchmark_now_seconds() - start);
+
+  if (sum != (long long)size * (size - 1) / 2)
+  {
+    printf("  pipeline lost elements!\n");
+  }
+
+  free_spsc_queue(&benchmark.queue);
+}
+
+void benchmark_deque()
+{
+  printf("Deque benchmarks\n");
+
+  // The first large allocation consolidates the nodes freed by earlier benchmarks, so it's
+  // done before any measure
+  Deque *warm_up = create_deque(1 << 20);
+  free_deque(&warm_up);
+
+  benchmark_fifo(20000);
+  benchmark_lifo(1000000);
+  benchmark_spsc(1000000);
+  printf("\n");
+}
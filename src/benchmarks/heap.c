@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+#include "binary_tree.h"
+#include "heap.h"
+
+static int *random_values(int count, int skewed)
+{
+  int *values = (int *)malloc(sizeof(int) * count);
+
+  for (int i = 0; i < count; i++)
+  {
+    // Skewed keys arrive almost sorted, which turns the binary tree into a list
+    values[i] = skewed ? i * 4 + rand() % 8 : rand();
+  }
+
+  return values;
+}
+
+// The approach used before heap.h existed: a binary search tree as priority queue
+static long long drain_binary_tree(const int *values, int count)
+{
+  BinaryTreeNode *head = NULL;
+  long long sum = 0;
+
+  for (int i = 0; i < count; i++)
+  {
+    insert_binary_tree_node(&head, values[i]);
+  }
+
+  while (head != NULL)
+  {
+    int max = find_binary_tree_max_node(head)->data;
+    sum += max;
+    head = delete_binary_tree_node(head, max);
+  }
+
+  return sum;
+}
+
+static long long drain_heap(const int *values, int count, int arity)
+{
+  Heap *heap = create_heap(MAX_HEAP, arity);
+  long long sum = 0;
+  int max = 0;
+
+  for (int i = 0; i < count; i++)
+  {
+    push_heap(heap, values[i]);
+  }
+
+  while (pop_heap(heap, &max) == 1)
+  {
+    sum += max;
+  }
+
+  free_heap(&heap);
+
+  return sum;
+}
+
+static void benchmark_priority_queue(int count, int skewed)
+{
+  printf(" push %d %s keys, then pop every maximum\n", count, skewed ? "skewed" : "random");
+
+  srand(11);
+  int *values = random_values(count, skewed);
+
+  double start = benchmark_now_seconds();
+  long long expected = drain_binary_tree(values, count);
+  benchmark_report("binary tree (find max + delete)", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  long long sum = drain_heap(values, count, 2);
+  benchmark_report("binary heap", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  sum += drain_heap(values, count, 0);
+  benchmark_report("4-ary heap", count, benchmark_now_seconds() - start);
+
+  if (sum != 2 * expected)
+  {
+    printf("  heaps and tree disagree!\n");
+  }
+
+  free(values);
+}
+
+static void benchmark_top_k(int count, int k)
+{
+  srand(13);
+  int *values = random_values(count, 0);
+  int *result = (int *)malloc(sizeof(int) * k);
+
+  char name[64];
+  snprintf(name, sizeof(name), "select_top_k (k = %d)", k);
+
+  double start = benchmark_now_seconds();
+  select_top_k(values, count, k, result);
+  benchmark_report(name, count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  Heap *heap = heapify_array(values, count, MAX_HEAP, 0);
+  for (int i = 0; i < k; i++)
+  {
+    pop_heap(heap, &result[i]);
+  }
+  benchmark_report("heapify_array + k pops", count, benchmark_now_seconds() - start);
+
+  free_heap(&heap);
+  free(result);
+  free(values);
+}
+
+void benchmark_heap()
+{
+  printf("Heap benchmarks\n");
+  benchmark_priority_queue(1000000, 0);
+  // Skewed keys make the tree quadratic, so the input is smaller
+  benchmark_priority_queue(10000, 1);
+  printf(" top-k of 1000000 values\n");
+  benchmark_top_k(1000000, 100);
+  printf("\n");
+}
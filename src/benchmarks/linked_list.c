@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+#include "linked_list.h"
+
+static int compare_ints(const void *first, const void *second)
+{
+  int a = *(const int *)first;
+  int b = *(const int *)second;
+
+  return (a > b) - (a < b);
+}
+
+static LinkedListNode *build_random_list(int size)
+{
+  LinkedListNode *head = NULL;
+
+  for (int i = 0; i < size; i++)
+  {
+    append_linked_list(&head, rand());
+  }
+
+  return head;
+}
+
+static void assert_sorted(LinkedListNode *head, int size)
+{
+  int counted_nodes = 0;
+
+  for (LinkedListNode *node = head; node != NULL; node = node->next, counted_nodes++)
+  {
+    if (node->next != NULL && node->next->data < node->data)
+    {
+      printf("  list is not sorted!\n");
+      return;
+    }
+  }
+
+  if (counted_nodes != size)
+  {
+    printf("  list lost nodes: %d of %d\n", counted_nodes, size);
+  }
+}
+
+// The approach used before sort_linked_list existed: copy into an array, sort it and
+// rebuild the list with push_linked_list
+static void copy_sort_rebuild(LinkedListNode **head, int size)
+{
+  int *values = (int *)malloc(sizeof(int) * size);
+  int i = 0;
+
+  for (LinkedListNode *node = *head; node != NULL; node = node->next)
+  {
+    values[i++] = node->data;
+  }
+
+  qsort(values, size, sizeof(int), compare_ints);
+  free_linked_list(head);
+
+  for (i = 0; i < size; i++)
+  {
+    push_linked_list(head, values[i]);
+  }
+
+  free(values);
+}
+
+static void benchmark_sort(int size)
+{
+  printf(" %d random nodes\n", size);
+
+  srand(42);
+  LinkedListNode *head = build_random_list(size);
+  double start = benchmark_now_seconds();
+  copy_sort_rebuild(&head, size);
+  benchmark_report("copy + qsort + push_linked_list rebuild", size, benchmark_now_seconds() - start);
+  assert_sorted(head, size);
+  free_linked_list(&head);
+
+  srand(42);
+  head = build_random_list(size);
+  start = benchmark_now_seconds();
+  sort_linked_list(&head);
+  benchmark_report("sort_linked_list", size, benchmark_now_seconds() - start);
+  assert_sorted(head, size);
+
+  // Natural runs: an already sorted list is done in a single pass
+  start = benchmark_now_seconds();
+  sort_linked_list(&head);
+  benchmark_report("sort_linked_list (already sorted)", size, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  reverse_linked_list(&head);
+  benchmark_report("reverse_linked_list", size, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  sort_linked_list(&head);
+  benchmark_report("sort_linked_list (reversed)", size, benchmark_now_seconds() - start);
+  assert_sorted(head, size);
+
+  free_linked_list(&head);
+}
+
+static void benchmark_k_way_merge(int lists_count, int list_size)
+{
+  LinkedListNode **lists = (LinkedListNode **)malloc(sizeof(LinkedListNode *) * lists_count);
+
+  srand(7);
+  for (int i = 0; i < lists_count; i++)
+  {
+    lists[i] = build_random_list(list_size);
+    sort_linked_list(&lists[i]);
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "merge_sorted_linked_lists (%d lists)", lists_count);
+
+  double start = benchmark_now_seconds();
+  LinkedListNode *merged = merge_sorted_linked_lists(lists, lists_count);
+  benchmark_report(name, lists_count * list_size, benchmark_now_seconds() - start);
+  assert_sorted(merged, lists_count * list_size);
+
+  free_linked_list(&merged);
+  free(lists);
+}
+
+void benchmark_linked_list()
+{
+  printf("Linked list benchmarks\n");
+  // push_linked_list walks the whole list, so the rebuild is quadratic and needs small inputs
+  benchmark_sort(2000);
+  benchmark_sort(20000);
+  benchmark_k_way_merge(64, 10000);
+  printf("\n");
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+#include "binary_tree.h"
+#include "radix_tree.h"
+
+static void shuffle(int *values, int count)
+{
+  for (int i = count - 1; i > 0; i--)
+  {
+    int j = rand() % (i + 1);
+    int temp = values[i];
+    values[i] = values[j];
+    values[j] = temp;
+  }
+}
+
+static void benchmark_key_set(const char *name, int *values, int count)
+{
+  printf(" %d %s keys\n", count, name);
+  int found = 0;
+
+  // Second lookups use 2 * key + 1: about half of them miss on dense keys and almost all on sparse keys
+  BinaryTreeNode *head = NULL;
+  double start = benchmark_now_seconds();
+  for (int i = 0; i < count; i++)
+  {
+    insert_binary_tree_node(&head, values[i]);
+  }
+  benchmark_report("insert_binary_tree_node", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  for (int i = 0; i < count; i++)
+  {
+    found += find_binary_tree_node(head, values[i]) != NULL;
+    found += find_binary_tree_node(head, (int)((unsigned int)values[i] * 2u + 1u)) != NULL;
+  }
+  benchmark_report("find_binary_tree_node (hits + misses)", 2 * count, benchmark_now_seconds() - start);
+
+  RadixTree *tree = create_radix_tree();
+  start = benchmark_now_seconds();
+  for (int i = 0; i < count; i++)
+  {
+    insert_radix_tree(tree, values[i]);
+  }
+  benchmark_report("insert_radix_tree", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  for (int i = 0; i < count; i++)
+  {
+    found -= search_radix_tree(tree, values[i]);
+    found -= search_radix_tree(tree, (int)((unsigned int)values[i] * 2u + 1u));
+  }
+  benchmark_report("search_radix_tree (hits + misses)", 2 * count, benchmark_now_seconds() - start);
+
+  int *sorted = (int *)malloc(sizeof(int) * count);
+  start = benchmark_now_seconds();
+  binary_tree_to_sorted_array(head, sorted, count);
+  benchmark_report("binary_tree_to_sorted_array", count, benchmark_now_seconds() - start);
+
+  start = benchmark_now_seconds();
+  radix_tree_to_sorted_array(tree, sorted, count);
+  benchmark_report("radix_tree_to_sorted_array", count, benchmark_now_seconds() - start);
+
+  if (found != 0)
+  {
+    printf("  trees disagree!\n");
+  }
+
+  free(sorted);
+  free_radix_tree(&tree);
+  free_binary_tree(&head);
+}
+
+void benchmark_radix_tree()
+{
+  int count = 1000000;
+  int *values = (int *)malloc(sizeof(int) * count);
+
+  printf("Radix tree benchmarks\n");
+
+  srand(19);
+  for (int i = 0; i < count; i++)
+  {
+    values[i] = i;
+  }
+  shuffle(values, count);
+  benchmark_key_set("dense", values, count);
+
+  // Multiplying by an odd constant keeps the keys distinct
+  for (int i = 0; i < count; i++)
+  {
+    values[i] = (int)((unsigned int)i * 2654435761u);
+  }
+  shuffle(values, count);
+  benchmark_key_set("sparse", values, count);
+
+  free(values);
+  printf("\n");
+}
@@ -1,8 +1,14 @@
 #include "../../include/binary_tree.h"
 
+#include <pthread.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+// Below this amount of values a range of a set operation is merged by the current thread
+#define BINARY_TREE_MIN_MERGE_SHARD 65536
 
 /**
  * @brief init a binary tree
@@ -201,7 +207,12 @@ BinaryTreeNode *find_binary_tree_max_node(BinaryTreeNode *node)
 }
 
 /**
- * @brief 
+ * @brief searches a node by its value
+ *
+ * @param node Binary tree head
+ * @param data value to search
+ *
+ * @returns Found Node, or NULL if the value isn't in the tree
  */
 BinaryTreeNode *find_binary_tree_node(BinaryTreeNode *node, int data)
 {
@@ -264,3 +275,696 @@ BinaryTreeNode *delete_binary_tree_node(BinaryTreeNode *head, int key)
 
   return head;
 }
+
+/**
+ * @brief removes a node from a binary tree and tells if it was there
+ *
+ * @param head A pointer to pointer of the Binary Tree Head
+ * @param data value to remove
+ *
+ * @returns amount of removed nodes (in this case can be only 1 or 0)
+ *
+ * This function walks down the tree once without recursion, so callers that need to know
+ * whether the value was there don't have to search for it first. A node with two children
+ * takes the lowest value of its right side, and that node is unlinked instead. Copies of that
+ * value come after it in order, so they stay at the right side like insert_binary_tree_node
+ * leaves them
+ *
+ * special cases:
+ *
+ * 1. If given pointer to pointer is null or the value isn't in the tree, then this function
+ * will return 0
+ */
+int remove_binary_tree_node(BinaryTreeNode **head, int data)
+{
+  /**
+   * Security measure: if given head is a null pointer, then we must return 0
+   */
+  if (head == NULL)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) Finds the slot that points to the first node with the value
+   */
+  BinaryTreeNode **slot = head;
+
+  while (*slot != NULL && (*slot)->data != data)
+  {
+    slot = (data < (*slot)->data) ? &(*slot)->left : &(*slot)->right;
+  }
+
+  BinaryTreeNode *node = *slot;
+
+  if (node == NULL)
+  {
+    return 0;
+  }
+
+  /**
+   * 2) A node with a missing side is replaced by its other side
+   */
+  if (node->left == NULL || node->right == NULL)
+  {
+    *slot = (node->left != NULL) ? node->left : node->right;
+    free(node);
+    return 1;
+  }
+
+  /**
+   * 3) Otherwise the lowest node of the right side gives its value and is unlinked, it has no
+   * left side
+   */
+  BinaryTreeNode **min_slot = &node->right;
+
+  while ((*min_slot)->left != NULL)
+  {
+    min_slot = &(*min_slot)->left;
+  }
+
+  BinaryTreeNode *min_node = *min_slot;
+  node->data = min_node->data;
+  *min_slot = min_node->right;
+  free(min_node);
+
+  return 1;
+}
+
+/**
+ * @brief frees every node of a binary tree
+ *
+ * @param head A pointer to pointer of the Binary Tree Head
+ *
+ * @returns amount of freed nodes
+ *
+ * This function frees all the nodes of a binary tree without recursion, so degenerate trees
+ * (which look like a linked list) can't overflow the call stack
+ *
+ * special cases:
+ *
+ * 1. If given pointer to pointer is null or the tree is empty, then this function will return 0
+ */
+int free_binary_tree(BinaryTreeNode **head)
+{
+  /**
+   * Security measure: if given head is a null pointer, then we must return 0
+   */
+  if (head == NULL || *head == NULL)
+  {
+    return 0;
+  }
+
+  int freed_nodes = 0;
+  BinaryTreeNode *current_node = *head;
+
+  while (current_node != NULL)
+  {
+    /**
+     * 1) If current node has a left side, we rotate it to the right so the left child becomes
+     * the new current node. This way the tree ends up flattened into a right spine
+     */
+    if (current_node->left != NULL)
+    {
+      BinaryTreeNode *left_node = current_node->left;
+      current_node->left = left_node->right;
+      left_node->right = current_node;
+      current_node = left_node;
+      continue;
+    }
+
+    /**
+     * 2) When there's no left side the node can be freed safely
+     */
+    BinaryTreeNode *next_node = current_node->right;
+    free(current_node);
+    freed_nodes++;
+    current_node = next_node;
+  }
+
+  *head = NULL;
+
+  return freed_nodes;
+}
+
+/**
+ * @brief counts the nodes of a binary tree
+ *
+ * @param head Binary tree head
+ *
+ * @returns amount of nodes in the tree, or -1 if the auxiliar stack can't be allocated
+ *
+ * This function only reads the tree, so it can run while other threads read it too. The stack
+ * starts small and doubles when a deep tree needs it, so degenerate trees can't overflow the
+ * call stack
+ */
+int count_binary_tree_nodes(BinaryTreeNode *head)
+{
+  if (head == NULL)
+  {
+    return 0;
+  }
+
+  int stack_capacity = 64;
+  BinaryTreeNode **stack = (BinaryTreeNode **)malloc(sizeof(BinaryTreeNode *) * stack_capacity);
+
+  if (stack == NULL)
+  {
+    return -1;
+  }
+
+  int stack_size = 0;
+  int counted_nodes = 0;
+  BinaryTreeNode *current_node = head;
+
+  /**
+   * 1) Every node is counted when it's taken from the stack, then its left side is walked down
+   * and its right side is kept for later
+   */
+  while (current_node != NULL || stack_size > 0)
+  {
+    if (current_node == NULL)
+    {
+      current_node = stack[--stack_size];
+    }
+
+    counted_nodes++;
+
+    if (current_node->right != NULL)
+    {
+      /**
+       * Security measure: if the stack can't grow, then we must return -1
+       */
+      if (stack_size == stack_capacity)
+      {
+        BinaryTreeNode **new_stack = (BinaryTreeNode **)realloc(stack, sizeof(BinaryTreeNode *) * stack_capacity * 2);
+
+        if (new_stack == NULL)
+        {
+          free(stack);
+          return -1;
+        }
+
+        stack = new_stack;
+        stack_capacity *= 2;
+      }
+
+      stack[stack_size++] = current_node->right;
+    }
+
+    current_node = current_node->left;
+  }
+
+  free(stack);
+
+  return counted_nodes;
+}
+
+/**
+ * @brief copies the values of a binary tree into an array following inorder route
+ *
+ * @param head Binary tree head
+ * @param array Destination array, it must have room for every node of the tree
+ * @param size Capacity of the destination array
+ *
+ * @returns amount of copied values, or -1 if the auxiliar stack can't be allocated
+ *
+ * Because this is a binary search tree, the resulting array is sorted. The route is done with
+ * an explicit stack so degenerate trees can't overflow the call stack
+ */
+int binary_tree_to_sorted_array(BinaryTreeNode *head, int *array, int size)
+{
+  if (head == NULL || array == NULL || size <= 0)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) The stack can never hold more nodes than the tree has, so size is a safe bound
+   */
+  BinaryTreeNode **stack = (BinaryTreeNode **)malloc(sizeof(BinaryTreeNode *) * size);
+
+  if (stack == NULL)
+  {
+    return -1;
+  }
+
+  int stack_size = 0;
+  int copied_values = 0;
+  BinaryTreeNode *current_node = head;
+
+  /**
+   * 2) Goes as left as possible, then visits the node and moves to its right side
+   */
+  while ((current_node != NULL || stack_size > 0) && copied_values < size)
+  {
+    while (current_node != NULL && stack_size < size)
+    {
+      stack[stack_size++] = current_node;
+      current_node = current_node->left;
+    }
+
+    current_node = stack[--stack_size];
+    array[copied_values++] = current_node->data;
+    current_node = current_node->right;
+  }
+
+  free(stack);
+
+  return copied_values;
+}
+
+/**
+ * @brief finds the first position of a sorted array whose value isn't lower than a key
+ *
+ * @param array Sorted array
+ * @param size Amount of values
+ * @param key Searched key
+ *
+ * @returns position between 0 and size
+ */
+static int lower_bound_sorted_array(const int *array, int size, int key)
+{
+  int low = 0, high = size;
+
+  while (low < high)
+  {
+    int middle = low + (high - low) / 2;
+
+    if (array[middle] < key)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+/**
+ * @brief builds a balanced binary tree from a sorted array
+ *
+ * @param array Sorted values
+ * @param size Amount of values
+ *
+ * @returns head of the new binary tree
+ *
+ * Every node takes the first copy of the middle value of its range, so equal values stay at
+ * the right side like insert_binary_tree_node leaves them, and the height of the resulting
+ * tree is log2(size) plus the longest run of equal values. Left ranges are at most half of
+ * their parent and are built recursively, right ranges are built by the loop, so the
+ * recursion depth is log2(size) even with long runs of equal values
+ *
+ * special cases:
+ *
+ * 1. If size is 0, then this function will return a null pointer
+ *
+ * 2. If a node can't be allocated, then every node already created is freed and this function
+ * will return a null pointer
+ */
+BinaryTreeNode *build_binary_tree_from_sorted_array(const int *array, int size)
+{
+  if (array == NULL || size <= 0)
+  {
+    return NULL;
+  }
+
+  BinaryTreeNode *head = NULL;
+  BinaryTreeNode **slot = &head;
+
+  while (size > 0)
+  {
+    /**
+     * 1) The node takes the first copy of the middle value, the values before it go left
+     */
+    int middle = lower_bound_sorted_array(array, size / 2, array[size / 2]);
+
+    BinaryTreeNode *new_node = create_binary_tree_node();
+
+    if (new_node == NULL)
+    {
+      free_binary_tree(&head);
+      return NULL;
+    }
+
+    new_node->data = array[middle];
+    *slot = new_node;
+
+    if (middle > 0)
+    {
+      new_node->left = build_binary_tree_from_sorted_array(array, middle);
+
+      if (new_node->left == NULL)
+      {
+        free_binary_tree(&head);
+        return NULL;
+      }
+    }
+
+    /**
+     * 2) The values after it, copies included, are built as its right side
+     */
+    slot = &new_node->right;
+    array += middle + 1;
+    size -= middle + 1;
+  }
+
+  return head;
+}
+
+/**
+ * Which values of the two inputs are kept by merge_sorted_arrays
+ */
+typedef enum BinaryTreeSetOperation
+{
+  SET_UNION,
+  SET_INTERSECTION,
+  SET_DIFFERENCE
+} BinaryTreeSetOperation;
+
+/**
+ * @brief merges two sorted arrays applying a set operation
+ *
+ * @param first First sorted array
+ * @param first_size Amount of values of the first array
+ * @param second Second sorted array
+ * @param second_size Amount of values of the second array
+ * @param result Destination array, it must have room for first_size + second_size values
+ * @param operation Set operation to apply
+ *
+ * @returns amount of values written into result
+ *
+ * Repeated values are written only once, so the result is always a set
+ */
+static int merge_sorted_arrays(const int *first, int first_size, const int *second, int second_size,
+                               int *result, BinaryTreeSetOperation operation)
+{
+  int i = 0, j = 0, result_size = 0;
+
+  while (i < first_size || j < second_size)
+  {
+    /**
+     * 1) Takes the smallest value of both heads and checks where it comes from
+     */
+    int value;
+
+    if (j >= second_size || (i < first_size && first[i] <= second[j]))
+    {
+      value = first[i];
+    }
+    else
+    {
+      value = second[j];
+    }
+
+    bool in_first = i < first_size && first[i] == value;
+    bool in_second = j < second_size && second[j] == value;
+
+    /**
+     * 2) Skips every copy of the value on both sides
+     */
+    while (i < first_size && first[i] == value)
+    {
+      i++;
+    }
+
+    while (j < second_size && second[j] == value)
+    {
+      j++;
+    }
+
+    /**
+     * 3) Keeps the value only if the operation wants it
+     */
+    if ((operation == SET_UNION) ||
+        (operation == SET_INTERSECTION && in_first && in_second) ||
+        (operation == SET_DIFFERENCE && in_first && !in_second))
+    {
+      result[result_size++] = value;
+    }
+  }
+
+  return result_size;
+}
+
+// Work of one range of a parallel merge
+typedef struct BinaryTreeMergeShard
+{
+  const int *first;
+  int first_size;
+  const int *second;
+  int second_size;
+  int *result;
+  BinaryTreeSetOperation operation;
+  int forks;
+  int result_size;
+} BinaryTreeMergeShard;
+
+static void *process_binary_tree_merge_shard(void *argument);
+
+/**
+ * @brief merges a range of both arrays, forking while there are threads left
+ *
+ * @param shard range of both arrays and its place in the result
+ *
+ * Both arrays are cut at the same pivot value, so the left halves only hold values lower than
+ * the pivot and the right halves the rest. The halves never share a value and can be merged
+ * at the same time: the left one by a new thread and the right one by the current thread
+ */
+static void run_binary_tree_merge_shard(BinaryTreeMergeShard *shard)
+{
+  /**
+   * 1) The pivot is the first copy of the middle value of the longest array
+   */
+  const int *longest = shard->first_size >= shard->second_size ? shard->first : shard->second;
+  int longest_size = shard->first_size >= shard->second_size ? shard->first_size : shard->second_size;
+  int middle = longest_size / 2;
+
+  while (middle > 0 && longest[middle - 1] == longest[middle])
+  {
+    middle--;
+  }
+
+  if (shard->forks <= 0 || shard->first_size + shard->second_size < 2 * BINARY_TREE_MIN_MERGE_SHARD || middle == 0)
+  {
+    shard->result_size = merge_sorted_arrays(shard->first, shard->first_size, shard->second, shard->second_size,
+                                             shard->result, shard->operation);
+    return;
+  }
+
+  int pivot = longest[middle];
+  int first_middle = lower_bound_sorted_array(shard->first, shard->first_size, pivot);
+  int second_middle = lower_bound_sorted_array(shard->second, shard->second_size, pivot);
+
+  /**
+   * 2) Every half writes where the result would be if nothing was dropped
+   */
+  BinaryTreeMergeShard left = {shard->first, first_middle, shard->second, second_middle,
+                               shard->result, shard->operation, shard->forks - 1, 0};
+  BinaryTreeMergeShard right = {shard->first + first_middle, shard->first_size - first_middle,
+                                shard->second + second_middle, shard->second_size - second_middle,
+                                shard->result + first_middle + second_middle, shard->operation, shard->forks - 1, 0};
+
+  /**
+   * 3) If a thread can't be created, the left half is merged by this thread too
+   */
+  pthread_t thread;
+  int forked = pthread_create(&thread, NULL, process_binary_tree_merge_shard, &left) == 0;
+
+  run_binary_tree_merge_shard(&right);
+
+  if (forked)
+  {
+    pthread_join(thread, NULL);
+  }
+  else
+  {
+    run_binary_tree_merge_shard(&left);
+  }
+
+  /**
+   * 4) Closes the gap between both halves
+   */
+  memmove(shard->result + left.result_size, right.result, sizeof(int) * right.result_size);
+  shard->result_size = left.result_size + right.result_size;
+}
+
+static void *process_binary_tree_merge_shard(void *argument)
+{
+  run_binary_tree_merge_shard((BinaryTreeMergeShard *)argument);
+
+  return NULL;
+}
+
+// Flattening of one input tree, so both inputs can be read at the same time
+typedef struct BinaryTreeFlattenShard
+{
+  BinaryTreeNode *head;
+  int *array;
+  int size;
+  int copied_values;
+} BinaryTreeFlattenShard;
+
+static void *process_binary_tree_flatten_shard(void *argument)
+{
+  BinaryTreeFlattenShard *shard = (BinaryTreeFlattenShard *)argument;
+
+  shard->copied_values = binary_tree_to_sorted_array(shard->head, shard->array, shard->size);
+
+  return NULL;
+}
+
+/**
+ * @brief applies a set operation over two binary trees
+ *
+ * @param first First binary tree head
+ * @param second Second binary tree head
+ * @param operation Set operation to apply
+ *
+ * @returns head of a new balanced binary tree
+ *
+ * Both trees are flattened into sorted arrays, merged in linear time and the result is
+ * built as a balanced tree. Given trees aren't modified. Large inputs are flattened by two
+ * threads and merged by one thread per online processor
+ */
+static BinaryTreeNode *apply_binary_tree_set_operation(BinaryTreeNode *first, BinaryTreeNode *second,
+                                                       BinaryTreeSetOperation operation)
+{
+  int first_size = count_binary_tree_nodes(first);
+  int second_size = count_binary_tree_nodes(second);
+
+  if (first_size < 0 || second_size < 0 || first_size + second_size == 0)
+  {
+    return NULL;
+  }
+
+  /**
+   * 1) A single buffer holds both inputs and the merged output
+   */
+  int *buffer = (int *)malloc(sizeof(int) * 2 * (first_size + second_size));
+
+  if (buffer == NULL)
+  {
+    return NULL;
+  }
+
+  int *first_values = buffer;
+  int *second_values = buffer + first_size;
+  int *result_values = buffer + first_size + second_size;
+
+  /**
+   * 2) Every fork doubles the threads, so log2(processors) levels of forks are used. With a
+   * single online processor, or small inputs, nothing is forked at all
+   */
+  long processors = first_size + second_size >= 2 * BINARY_TREE_MIN_MERGE_SHARD ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+  int forks = 0;
+
+  while ((1L << (forks + 1)) <= processors && forks < 6)
+  {
+    forks++;
+  }
+
+  /**
+   * 3) Flattens the first tree in a new thread while this thread flattens the second one
+   */
+  BinaryTreeFlattenShard first_shard = {first, first_values, first_size, 0};
+  BinaryTreeFlattenShard second_shard = {second, second_values, second_size, 0};
+  pthread_t thread;
+  bool forked = forks > 0 && pthread_create(&thread, NULL, process_binary_tree_flatten_shard, &first_shard) == 0;
+
+  process_binary_tree_flatten_shard(&second_shard);
+
+  if (forked)
+  {
+    pthread_join(thread, NULL);
+  }
+  else
+  {
+    process_binary_tree_flatten_shard(&first_shard);
+  }
+
+  if (first_shard.copied_values < 0 || second_shard.copied_values < 0)
+  {
+    free(buffer);
+    return NULL;
+  }
+
+  /**
+   * 4) Merges both sorted streams and builds the resulting tree
+   */
+  BinaryTreeMergeShard shard = {first_values, first_size, second_values, second_size,
+                                result_values, operation, forks, 0};
+  run_binary_tree_merge_shard(&shard);
+
+  BinaryTreeNode *result = build_binary_tree_from_sorted_array(result_values, shard.result_size);
+
+  free(buffer);
+
+  return result;
+}
+
+/**
+ * @brief creates a binary tree with the values that are in any of the given trees
+ *
+ * @param first First binary tree head
+ * @param second Second binary tree head
+ *
+ * @returns head of a new balanced binary tree
+ *
+ * This function runs in O(n + m). Given trees aren't modified and repeated values appear
+ * only once in the result
+ *
+ * special cases:
+ *
+ * 1. If both trees are empty or memory can't be allocated, then this function will return
+ * a null pointer
+ */
+BinaryTreeNode *union_binary_tree(BinaryTreeNode *first, BinaryTreeNode *second)
+{
+  return apply_binary_tree_set_operation(first, second, SET_UNION);
+}
+
+/**
+ * @brief creates a binary tree with the values that are in both given trees
+ *
+ * @param first First binary tree head
+ * @param second Second binary tree head
+ *
+ * @returns head of a new balanced binary tree
+ *
+ * This function runs in O(n + m). Given trees aren't modified and repeated values appear
+ * only once in the result
+ *
+ * special cases:
+ *
+ * 1. If there are no common values or memory can't be allocated, then this function will
+ * return a null pointer
+ */
+BinaryTreeNode *intersection_binary_tree(BinaryTreeNode *first, BinaryTreeNode *second)
+{
+  return apply_binary_tree_set_operation(first, second, SET_INTERSECTION);
+}
+
+/**
+ * @brief creates a binary tree with the values of the first tree that aren't in the second one
+ *
+ * @param first First binary tree head
+ * @param second Second binary tree head
+ *
+ * @returns head of a new balanced binary tree
+ *
+ * This function runs in O(n + m). Given trees aren't modified and repeated values appear
+ * only once in the result
+ *
+ * special cases:
+ *
+ * 1. If the result is empty or memory can't be allocated, then this function will return
+ * a null pointer
+ */
+BinaryTreeNode *difference_binary_tree(BinaryTreeNode *first, BinaryTreeNode *second)
+{
+  return apply_binary_tree_set_operation(first, second, SET_DIFFERENCE);
+}
@@ -0,0 +1,410 @@
+#include "../../include/bloom_filter.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief hashes a key into 64 well mixed bits
+ *
+ * @param key key to hash
+ *
+ * @returns hash of the key
+ *
+ * The high half chooses the block and the low half the bits inside it
+ */
+static uint64_t hash_bloom_filter_key(int key)
+{
+  uint64_t hash = (uint64_t)(uint32_t)key + 0x9e3779b97f4a7c15ull;
+
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+
+  return hash ^ (hash >> 31);
+}
+
+/**
+ * @brief finds the block of a hash
+ *
+ * @param filter Target filter
+ * @param hash hash of the key
+ *
+ * @returns first word of the block
+ *
+ * Multiplying by the amount of blocks maps the hash into range without a division
+ */
+static inline uint64_t *find_bloom_filter_block(const BloomFilter *filter, uint64_t hash)
+{
+  uint32_t block = (uint32_t)(((hash >> 32) * (uint64_t)filter->blocks_count) >> 32);
+
+  return filter->blocks + (size_t)block * BLOOM_FILTER_BLOCK_WORDS;
+}
+
+/**
+ * @brief init a blocked Bloom filter
+ *
+ * @param expected_keys amount of keys the filter is sized for
+ * @param bits_per_key bits used for every expected key, 10 gives about 1% false positives
+ *
+ * @returns created filter
+ *
+ * Special cases:
+ *
+ * 1. If the filter can't be allocated in memory, then this function will return a null pointer
+ */
+BloomFilter *create_bloom_filter(int expected_keys, int bits_per_key)
+{
+  if (expected_keys < 1)
+  {
+    expected_keys = 1;
+  }
+
+  if (bits_per_key < 1)
+  {
+    bits_per_key = 10;
+  }
+
+  BloomFilter *new_filter = (BloomFilter *)malloc(sizeof(BloomFilter));
+
+  /**
+   * Security measure: if filter can't be allocated, then we must return null
+   */
+  if (new_filter == NULL)
+  {
+    return NULL;
+  }
+
+  /**
+   * 1) The amount of hashes that minimizes false positives is bits_per_key * ln(2)
+   */
+  uint64_t bits = (uint64_t)expected_keys * (uint64_t)bits_per_key;
+  uint64_t blocks_count = (bits + 511) / 512;
+
+  new_filter->blocks_count = (uint32_t)blocks_count;
+  new_filter->hashes = (int)(bits_per_key * 0.693 + 0.5);
+  new_filter->hashes = (new_filter->hashes < 1) ? 1 : (new_filter->hashes > 16) ? 16 : new_filter->hashes;
+  new_filter->keys = 0;
+  new_filter->stale_keys = 0;
+
+  /**
+   * 2) Blocks are aligned to a cache line
+   */
+  new_filter->blocks = (uint64_t *)aligned_alloc(64, blocks_count * 64);
+
+  if (new_filter->blocks == NULL)
+  {
+    free(new_filter);
+    return NULL;
+  }
+
+  memset(new_filter->blocks, 0, blocks_count * 64);
+
+  return new_filter;
+}
+
+/**
+ * @brief frees a blocked Bloom filter
+ *
+ * @param filter pointer to the filter variable
+ *
+ * @returns amount of keys that were added to the filter
+ */
+int free_bloom_filter(BloomFilter **filter)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (filter == NULL || *filter == NULL)
+  {
+    return 0;
+  }
+
+  int freed_keys = (*filter)->keys;
+
+  free((*filter)->blocks);
+  free(*filter);
+  *filter = NULL;
+
+  return freed_keys;
+}
+
+/**
+ * @brief adds a key to a blocked Bloom filter
+ *
+ * @param filter Target filter
+ * @param key key to add
+ *
+ * @returns amount of added keys during the operation
+ *
+ * The bit positions inside the block come from double hashing. The block takes the high 32
+ * bits of the hash, so two independent 9-bit fields below them give the first bit h1 and the
+ * odd step h2, and the i-th bit is h1 + i * h2
+ */
+int add_bloom_filter(BloomFilter *filter, int key)
+{
+  if (filter == NULL)
+  {
+    return 0;
+  }
+
+  uint64_t hash = hash_bloom_filter_key(key);
+  uint64_t *block = find_bloom_filter_block(filter, hash);
+  uint32_t first = (uint32_t)hash & 511;
+  uint32_t step = ((uint32_t)(hash >> 9) & 511) | 1;
+
+  for (int i = 0; i < filter->hashes; i++)
+  {
+    uint32_t bit = (first + i * step) & 511;
+    block[bit >> 6] |= 1ull << (bit & 63);
+  }
+
+  filter->keys++;
+
+  return 1;
+}
+
+/**
+ * @brief checks if a key may be in a blocked Bloom filter
+ *
+ * @param filter Target filter
+ * @param key key to check
+ *
+ * @returns 0 if the key was never added, 1 if it may have been added
+ */
+int may_contain_bloom_filter(const BloomFilter *filter, int key)
+{
+  /**
+   * Security measure: without a filter every key may be present
+   */
+  if (filter == NULL)
+  {
+    return 1;
+  }
+
+  uint64_t hash = hash_bloom_filter_key(key);
+  const uint64_t *block = find_bloom_filter_block(filter, hash);
+  uint32_t first = (uint32_t)hash & 511;
+  uint32_t step = ((uint32_t)(hash >> 9) & 511) | 1;
+
+  for (int i = 0; i < filter->hashes; i++)
+  {
+    uint32_t bit = (first + i * step) & 511;
+
+    if ((block[bit >> 6] & (1ull << (bit & 63))) == 0)
+    {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * @brief removes every key from a blocked Bloom filter
+ *
+ * @param filter Target filter
+ */
+void clear_bloom_filter(BloomFilter *filter)
+{
+  if (filter == NULL)
+  {
+    return;
+  }
+
+  memset(filter->blocks, 0, (size_t)filter->blocks_count * 64);
+  filter->keys = 0;
+  filter->stale_keys = 0;
+}
+
+/**
+ * @brief estimates the false positive rate of a blocked Bloom filter
+ *
+ * @param filter Target filter
+ *
+ * @returns probability that a key that was never added is reported as present
+ *
+ * A missing key lands in one block chosen at random, so the rate is the average over the
+ * blocks of (set bits / 512)^hashes. Loaded blocks weigh more than the global fill ratio
+ * suggests, and bits left by deleted keys are counted too. Two keys of a block with the same
+ * double hashing step share the bits where their sequences overlap, so the measured rate is
+ * about 13% higher than this estimate at 10 bits per key, and the gap grows with the hashes
+ */
+double bloom_filter_false_positive_rate(const BloomFilter *filter)
+{
+  if (filter == NULL || filter->blocks_count == 0)
+  {
+    return 1.0;
+  }
+
+  double false_positive_sum = 0.0;
+
+  for (uint32_t b = 0; b < filter->blocks_count; b++)
+  {
+    const uint64_t *block = filter->blocks + (size_t)b * BLOOM_FILTER_BLOCK_WORDS;
+    int set_bits = 0;
+
+    for (int i = 0; i < BLOOM_FILTER_BLOCK_WORDS; i++)
+    {
+      set_bits += __builtin_popcountll(block[i]);
+    }
+
+    /**
+     * A false positive needs every one of the hashes to hit a set bit of the block
+     */
+    double fill_ratio = set_bits / 512.0;
+    double block_rate = 1.0;
+
+    for (int i = 0; i < filter->hashes; i++)
+    {
+      block_rate *= fill_ratio;
+    }
+
+    false_positive_sum += block_rate;
+  }
+
+  return false_positive_sum / filter->blocks_count;
+}
+
+/**
+ * @brief computes the memory used by a blocked Bloom filter
+ *
+ * @param filter Target filter
+ *
+ * @returns amount of allocated bytes
+ */
+size_t bloom_filter_memory_usage(const BloomFilter *filter)
+{
+  if (filter == NULL)
+  {
+    return 0;
+  }
+
+  return sizeof(BloomFilter) + (size_t)filter->blocks_count * 64;
+}
+
+/**
+ * @brief creates a new node into a binary tree and adds its value to a filter
+ *
+ * @param head A pointer to pointer of the Binary Tree Head
+ * @param filter filter kept in sync with the tree, it can be null
+ * @param data value of the new node
+ *
+ * @returns amount of created nodes
+ */
+int insert_filtered_binary_tree_node(BinaryTreeNode **head, BloomFilter *filter, int data)
+{
+  int created_nodes = insert_binary_tree_node(head, data);
+
+  if (created_nodes > 0)
+  {
+    add_bloom_filter(filter, data);
+  }
+
+  return created_nodes;
+}
+
+/**
+ * @brief searches a node, asking the filter before walking the tree
+ *
+ * @param head Binary tree head
+ * @param filter filter kept in sync with the tree, it can be null
+ * @param data value to search
+ *
+ * @returns found node, or NULL if the value isn't in the tree
+ *
+ * Most absent values are rejected by the filter after reading one block, so only present
+ * values and false positives pay the walk from the root. The filter is a separate object, so
+ * it must have seen every value of the tree: a value inserted without
+ * insert_filtered_binary_tree_node is reported as absent until the filter is rebuilt
+ */
+BinaryTreeNode *find_filtered_binary_tree_node(BinaryTreeNode *head, const BloomFilter *filter, int data)
+{
+  if (!may_contain_bloom_filter(filter, data))
+  {
+    return NULL;
+  }
+
+  return find_binary_tree_node(head, data);
+}
+
+/**
+ * @brief deletes a node from a binary tree that has a filter kept in sync
+ *
+ * @param head Binary tree head
+ * @param filter filter kept in sync with the tree, it can be null
+ * @param data value to delete
+ *
+ * @returns new head of the tree
+ *
+ * Bits can't be removed from a Bloom filter, so the deleted value stays as a false positive.
+ * When stale values reach half of the keys the filter is rebuilt from the tree. Values the
+ * filter rejects aren't looked for, and the others cost a single walk from the root
+ */
+BinaryTreeNode *delete_filtered_binary_tree_node(BinaryTreeNode *head, BloomFilter *filter, int data)
+{
+  if (!may_contain_bloom_filter(filter, data) || remove_binary_tree_node(&head, data) == 0)
+  {
+    return head;
+  }
+
+  if (filter == NULL)
+  {
+    return head;
+  }
+
+  filter->stale_keys++;
+
+  if (filter->stale_keys * 2 >= filter->keys)
+  {
+    rebuild_bloom_filter(filter, head);
+  }
+
+  return head;
+}
+
+/**
+ * @brief fills a filter with the values of a binary tree
+ *
+ * @param filter Target filter
+ * @param head Binary tree head
+ *
+ * @returns amount of added keys, or -1 if memory can't be allocated
+ *
+ * The filter is cleared first, so the values of deleted nodes stop being reported
+ */
+int rebuild_bloom_filter(BloomFilter *filter, BinaryTreeNode *head)
+{
+  if (filter == NULL)
+  {
+    return 0;
+  }
+
+  int size = count_binary_tree_nodes(head);
+  int *values = NULL;
+
+  if (size < 0)
+  {
+    return -1;
+  }
+
+  if (size > 0)
+  {
+    values = (int *)malloc(sizeof(int) * size);
+
+    if (values == NULL || binary_tree_to_sorted_array(head, values, size) < 0)
+    {
+      free(values);
+      return -1;
+    }
+  }
+
+  clear_bloom_filter(filter);
+
+  for (int i = 0; i < size; i++)
+  {
+    add_bloom_filter(filter, values[i]);
+  }
+
+  free(values);
+
+  return size;
+}
@@ -0,0 +1,828 @@
+#include "../../include/compressed_list.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Size ratio from which intersections seek into the longest list instead of merging
+#define COMPRESSED_LIST_SEEK_RATIO 32
+
+// Differences are packed in this many interleaved lanes, one per SSE2 int lane
+#define COMPRESSED_LIST_LANES 4
+
+/**
+ * @brief init a compressed list
+ *
+ * @returns created list
+ *
+ * Special cases:
+ *
+ * 1. If the list can't be allocated in memory, then this function will return a null pointer
+ */
+CompressedList *create_compressed_list()
+{
+  CompressedList *new_list = (CompressedList *)malloc(sizeof(CompressedList));
+
+  /**
+   * Security measure: if list can't be allocated, then we must return null
+   */
+  if (new_list == NULL)
+  {
+    return NULL;
+  }
+
+  new_list->blocks = NULL;
+  new_list->blocks_count = 0;
+  new_list->blocks_capacity = 0;
+  new_list->words = NULL;
+  new_list->words_count = 0;
+  new_list->words_capacity = 0;
+  new_list->pending_count = 0;
+  new_list->size = 0;
+
+  return new_list;
+}
+
+/**
+ * @brief frees a compressed list
+ *
+ * @param list pointer to the list variable
+ *
+ * @returns amount of values that the list had
+ */
+int free_compressed_list(CompressedList **list)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (list == NULL || *list == NULL)
+  {
+    return 0;
+  }
+
+  int freed_values = (*list)->size;
+
+  free((*list)->blocks);
+  free((*list)->words);
+  free(*list);
+  *list = NULL;
+
+  return freed_values;
+}
+
+/**
+ * @brief compresses the pending values into a new block
+ *
+ * @param list Target list
+ *
+ * @returns 1 if the block was created, or 0 if memory can't be allocated
+ *
+ * The bit width of the block is the one of its greatest difference, so blocks with small
+ * gaps take a few bits per value
+ */
+static int flush_compressed_list(CompressedList *list)
+{
+  int count = list->pending_count;
+
+  if (count == 0)
+  {
+    return 1;
+  }
+
+  /**
+   * 1) Finds how many bits the greatest difference needs
+   */
+  uint32_t max_delta = 0;
+
+  for (int i = 1; i < count; i++)
+  {
+    uint32_t delta = (uint32_t)list->pending[i] - (uint32_t)list->pending[i - 1];
+    max_delta |= delta;
+  }
+
+  int bit_width = (max_delta == 0) ? 0 : 32 - __builtin_clz(max_delta);
+  int rows = (count + COMPRESSED_LIST_LANES - 1) / COMPRESSED_LIST_LANES;
+  uint32_t words = (uint32_t)(((rows * bit_width + 31) / 32) * COMPRESSED_LIST_LANES);
+
+  /**
+   * 2) Makes room for the header and the packed words
+   */
+  if (list->blocks_count == list->blocks_capacity)
+  {
+    int new_capacity = (list->blocks_capacity < 16) ? 16 : list->blocks_capacity * 2;
+    CompressedListBlock *new_blocks =
+        (CompressedListBlock *)realloc(list->blocks, sizeof(CompressedListBlock) * new_capacity);
+
+    if (new_blocks == NULL)
+    {
+      return 0;
+    }
+
+    list->blocks = new_blocks;
+    list->blocks_capacity = new_capacity;
+  }
+
+  /**
+   * One spare row after the block lets the decoder read two rows at any position
+   */
+  if (list->words_count + words + COMPRESSED_LIST_LANES > list->words_capacity)
+  {
+    uint32_t new_capacity = (list->words_capacity < 256) ? 256 : list->words_capacity;
+
+    while (list->words_count + words + COMPRESSED_LIST_LANES > new_capacity)
+    {
+      new_capacity *= 2;
+    }
+
+    uint32_t *new_words = (uint32_t *)realloc(list->words, sizeof(uint32_t) * new_capacity);
+
+    if (new_words == NULL)
+    {
+      return 0;
+    }
+
+    list->words = new_words;
+    list->words_capacity = new_capacity;
+  }
+
+  /**
+   * 3) Packs the differences into interleaved lanes: difference i goes to lane i % 4, and
+   * word w of a lane is stored at w * 4 + lane. Every lane then has its differences at the
+   * same bit positions, so the decoder can unpack four of them with the same shifts. The
+   * difference of the first value is always 0
+   */
+  uint32_t *packed = list->words + list->words_count;
+  memset(packed, 0, sizeof(uint32_t) * (words + COMPRESSED_LIST_LANES));
+
+  for (int i = 1; i < count && bit_width > 0; i++)
+  {
+    uint32_t delta = (uint32_t)list->pending[i] - (uint32_t)list->pending[i - 1];
+    int lane = i % COMPRESSED_LIST_LANES;
+    int bit = (i / COMPRESSED_LIST_LANES) * bit_width;
+    int word = (bit >> 5) * COMPRESSED_LIST_LANES + lane;
+    int shift = bit & 31;
+
+    packed[word] |= delta << shift;
+
+    if (shift + bit_width > 32)
+    {
+      packed[word + COMPRESSED_LIST_LANES] |= delta >> (32 - shift);
+    }
+  }
+
+  CompressedListBlock *block = &list->blocks[list->blocks_count++];
+  block->first = list->pending[0];
+  block->last = list->pending[count - 1];
+  block->offset = list->words_count;
+  block->bit_width = (uint8_t)bit_width;
+  block->count = (uint8_t)count;
+
+  list->words_count += words;
+  list->pending_count = 0;
+
+  return 1;
+}
+
+/**
+ * @brief adds a value at the end of a compressed list
+ *
+ * @param list Target list
+ * @param data value to add, it must be equal or greater than the last value
+ *
+ * @returns amount of added values during the operation
+ *
+ * Special cases:
+ *
+ * 1. If the value is lower than the last one or memory can't be allocated, then this
+ * function will return 0
+ */
+int append_compressed_list(CompressedList *list, int data)
+{
+  if (list == NULL)
+  {
+    return 0;
+  }
+
+  /**
+   * Security measure: the list must stay sorted
+   */
+  if (list->pending_count > 0 && data < list->pending[list->pending_count - 1])
+  {
+    return 0;
+  }
+
+  if (list->pending_count == 0 && list->blocks_count > 0 && data < list->blocks[list->blocks_count - 1].last)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) A full pending block that couldn't be flushed before is tried again
+   */
+  if (list->pending_count == COMPRESSED_LIST_BLOCK_SIZE && !flush_compressed_list(list))
+  {
+    return 0;
+  }
+
+  list->pending[list->pending_count++] = data;
+  list->size++;
+
+  if (list->pending_count == COMPRESSED_LIST_BLOCK_SIZE)
+  {
+    flush_compressed_list(list);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief decodes a block
+ *
+ * @param list Target list
+ * @param block block to decode
+ * @param values array with room for COMPRESSED_LIST_BLOCK_SIZE values
+ *
+ * @returns amount of decoded values
+ *
+ * The differences are unpacked first and then added up. With SSE2 both steps are done four
+ * values at a time: the four lanes of a row share their bit position, so a row is unpacked
+ * with the same two shifts for every lane
+ */
+static int decode_compressed_list_block(const CompressedList *list, const CompressedListBlock *block, int *values)
+{
+  int count = block->count;
+  int bit_width = block->bit_width;
+  uint32_t *deltas = (uint32_t *)values;
+  const uint32_t *packed = list->words + block->offset;
+
+  /**
+   * 1) Unpacks the differences. The first one is 0, so adding the first value to it lets
+   * the sum start from there
+   */
+  if (bit_width == 0)
+  {
+    memset(deltas, 0, sizeof(uint32_t) * count);
+  }
+  else
+  {
+    uint32_t mask = (uint32_t)((1ull << bit_width) - 1);
+    int i = 0;
+
+    /**
+     * Two rows hold any difference, and the spare row after every block makes reading the
+     * second one always safe, so there's no branch per row. A difference that fits in the
+     * first row gets only bits above its width from the second one, which the mask clears
+     */
+#ifdef __SSE2__
+    __m128i vector_mask = _mm_set1_epi32((int)mask);
+
+    for (; i + COMPRESSED_LIST_LANES <= count; i += COMPRESSED_LIST_LANES)
+    {
+      int bit = (i / COMPRESSED_LIST_LANES) * bit_width;
+      const uint32_t *row = packed + (bit >> 5) * COMPRESSED_LIST_LANES;
+      __m128i low = _mm_loadu_si128((const __m128i *)row);
+      __m128i high = _mm_loadu_si128((const __m128i *)(row + COMPRESSED_LIST_LANES));
+
+      /**
+       * Shifting a lane left by 32 bits gives 0, which is what a difference that starts at
+       * bit 0 needs from the second row
+       */
+      low = _mm_srl_epi32(low, _mm_cvtsi32_si128(bit & 31));
+      high = _mm_sll_epi32(high, _mm_cvtsi32_si128(32 - (bit & 31)));
+      _mm_storeu_si128((__m128i *)(deltas + i), _mm_and_si128(_mm_or_si128(low, high), vector_mask));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+      int bit = (i / COMPRESSED_LIST_LANES) * bit_width;
+      int word = (bit >> 5) * COMPRESSED_LIST_LANES + i % COMPRESSED_LIST_LANES;
+      uint64_t pair = (uint64_t)packed[word] | ((uint64_t)packed[word + COMPRESSED_LIST_LANES] << 32);
+
+      deltas[i] = (uint32_t)(pair >> (bit & 31)) & mask;
+    }
+  }
+
+  deltas[0] += (uint32_t)block->first;
+
+  /**
+   * 2) Prefix sum of the differences
+   */
+  int i = 0;
+
+#ifdef __SSE2__
+  __m128i carry = _mm_setzero_si128();
+
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i sum = _mm_loadu_si128((const __m128i *)(deltas + i));
+    sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 4));
+    sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+    sum = _mm_add_epi32(sum, carry);
+    _mm_storeu_si128((__m128i *)(deltas + i), sum);
+    carry = _mm_shuffle_epi32(sum, 0xFF);
+  }
+#endif
+
+  for (i = (i == 0) ? 1 : i; i < count; i++)
+  {
+    deltas[i] += deltas[i - 1];
+  }
+
+  return count;
+}
+
+/**
+ * @brief copies every value of a compressed list into an array
+ *
+ * @param list Target list
+ * @param array Destination array
+ * @param size Capacity of the destination array
+ *
+ * @returns amount of copied values
+ */
+int compressed_list_to_array(const CompressedList *list, int *array, int size)
+{
+  if (list == NULL || array == NULL)
+  {
+    return 0;
+  }
+
+  int copied_values = 0;
+
+  /**
+   * 1) Full blocks are decoded straight into the array
+   */
+  for (int b = 0; b < list->blocks_count; b++)
+  {
+    const CompressedListBlock *block = &list->blocks[b];
+
+    if (copied_values + block->count > size)
+    {
+      int values[COMPRESSED_LIST_BLOCK_SIZE];
+      decode_compressed_list_block(list, block, values);
+      memcpy(array + copied_values, values, sizeof(int) * (size - copied_values));
+
+      return size;
+    }
+
+    copied_values += decode_compressed_list_block(list, block, array + copied_values);
+  }
+
+  /**
+   * 2) Pending values aren't compressed yet
+   */
+  int pending = list->pending_count;
+
+  if (pending > size - copied_values)
+  {
+    pending = size - copied_values;
+  }
+
+  memcpy(array + copied_values, list->pending, sizeof(int) * pending);
+
+  return copied_values + pending;
+}
+
+/**
+ * @brief computes the memory used by a compressed list
+ *
+ * @param list Target list
+ *
+ * @returns amount of allocated bytes
+ */
+size_t compressed_list_memory_usage(const CompressedList *list)
+{
+  if (list == NULL)
+  {
+    return 0;
+  }
+
+  return sizeof(CompressedList) + sizeof(CompressedListBlock) * list->blocks_capacity +
+         sizeof(uint32_t) * list->words_capacity;
+}
+
+/**
+ * @brief loads a block into an iterator
+ *
+ * @param iterator Target iterator
+ * @param block block to load, blocks_count means the pending values
+ */
+static void load_compressed_list_block(CompressedListIterator *iterator, int block)
+{
+  const CompressedList *list = iterator->list;
+
+  iterator->block = block;
+  iterator->position = 0;
+
+  if (block < list->blocks_count)
+  {
+    iterator->count = decode_compressed_list_block(list, &list->blocks[block], iterator->values);
+    return;
+  }
+
+  iterator->count = list->pending_count;
+  memcpy(iterator->values, list->pending, sizeof(int) * list->pending_count);
+}
+
+/**
+ * @brief prepares a sequential read of a compressed list
+ *
+ * @param iterator iterator to initialize
+ * @param list Target list
+ *
+ * The iterator keeps a copy of the block it reads, and the pending values become a new block
+ * when they are flushed. Appending to the list invalidates its iterators
+ */
+void init_compressed_list_iterator(CompressedListIterator *iterator, const CompressedList *list)
+{
+  if (iterator == NULL)
+  {
+    return;
+  }
+
+  iterator->list = list;
+  iterator->block = 0;
+  iterator->position = 0;
+  iterator->count = 0;
+
+  if (list != NULL)
+  {
+    load_compressed_list_block(iterator, 0);
+  }
+}
+
+/**
+ * @brief takes the next value of a compressed list
+ *
+ * @param iterator initialized iterator
+ * @param data variable where the value is stored
+ *
+ * @returns 1 if a value was taken, or 0 when the list is over
+ */
+int next_compressed_list_iterator(CompressedListIterator *iterator, int *data)
+{
+  if (iterator == NULL || iterator->list == NULL || data == NULL)
+  {
+    return 0;
+  }
+
+  while (iterator->position >= iterator->count)
+  {
+    /**
+     * The pending values are the last block
+     */
+    if (iterator->block >= iterator->list->blocks_count)
+    {
+      return 0;
+    }
+
+    load_compressed_list_block(iterator, iterator->block + 1);
+  }
+
+  *data = iterator->values[iterator->position++];
+
+  return 1;
+}
+
+/**
+ * @brief takes the rest of the current block of a compressed list
+ *
+ * @param iterator initialized iterator
+ * @param values variable where a pointer to the taken values is stored
+ *
+ * @returns amount of taken values, or 0 when the list is over
+ *
+ * Sequential scans that read a whole block per call avoid the per value checks of
+ * next_compressed_list_iterator. The values stay valid until the iterator moves again
+ */
+int next_block_compressed_list_iterator(CompressedListIterator *iterator, const int **values)
+{
+  if (iterator == NULL || iterator->list == NULL || values == NULL)
+  {
+    return 0;
+  }
+
+  while (iterator->position >= iterator->count)
+  {
+    if (iterator->block >= iterator->list->blocks_count)
+    {
+      return 0;
+    }
+
+    load_compressed_list_block(iterator, iterator->block + 1);
+  }
+
+  int taken_values = iterator->count - iterator->position;
+
+  *values = iterator->values + iterator->position;
+  iterator->position = iterator->count;
+
+  return taken_values;
+}
+
+/**
+ * @brief moves an iterator to the first value that is equal or greater than a target
+ *
+ * @param iterator initialized iterator
+ * @param target value to reach
+ * @param data variable where the found value is stored
+ *
+ * @returns 1 if a value was found, or 0 when the list is over
+ *
+ * The skip headers are searched with a binary search, so only the block that holds the
+ * value is decoded. The iterator never moves backwards
+ */
+int next_geq_compressed_list_iterator(CompressedListIterator *iterator, int target, int *data)
+{
+  if (iterator == NULL || iterator->list == NULL || data == NULL)
+  {
+    return 0;
+  }
+
+  const CompressedList *list = iterator->list;
+
+  /**
+   * 1) If the target is beyond the current block, looks for the first block whose last
+   * value reaches it
+   */
+  if (iterator->position >= iterator->count || iterator->values[iterator->count - 1] < target)
+  {
+    int low = iterator->block + 1;
+    int high = list->blocks_count;
+
+    while (low < high)
+    {
+      int middle = low + (high - low) / 2;
+
+      if (list->blocks[middle].last < target)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+
+    if (low > list->blocks_count)
+    {
+      iterator->position = iterator->count;
+      return 0;
+    }
+
+    load_compressed_list_block(iterator, low);
+
+    if (iterator->count == 0 || iterator->values[iterator->count - 1] < target)
+    {
+      iterator->block = list->blocks_count;
+      iterator->position = iterator->count;
+      return 0;
+    }
+  }
+
+  /**
+   * 2) Targets are usually close when both lists have the same density, so a few values are
+   * checked one by one before the binary search inside the decoded block
+   */
+  int low = iterator->position;
+  int high = iterator->count - 1;
+  int probe_end = (low + 8 < high) ? low + 8 : high;
+
+  while (low < probe_end && iterator->values[low] < target)
+  {
+    low++;
+  }
+
+  while (low < high)
+  {
+    int middle = low + (high - low) / 2;
+
+    if (iterator->values[middle] < target)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  *data = iterator->values[low];
+  iterator->position = low + 1;
+
+  return 1;
+}
+
+/**
+ * @brief moves an iterator to the first block that may hold values equal or greater than a target
+ *
+ * @param iterator initialized iterator whose current block is over
+ * @param target value that the other list is at
+ *
+ * @returns 1 if a block was loaded, or 0 when the list is over
+ *
+ * Blocks that end before the target are passed using only their skip headers
+ */
+static int skip_compressed_list_blocks(CompressedListIterator *iterator, int target)
+{
+  const CompressedList *list = iterator->list;
+
+  while (iterator->position >= iterator->count)
+  {
+    if (iterator->block >= list->blocks_count)
+    {
+      return 0;
+    }
+
+    int block = iterator->block + 1;
+
+    while (block < list->blocks_count && list->blocks[block].last < target)
+    {
+      block++;
+    }
+
+    load_compressed_list_block(iterator, block);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief intersects two lists of similar size by merging their decoded blocks
+ *
+ * @param first First list
+ * @param second Second list
+ * @param result Destination array
+ * @param size Capacity of the destination array
+ *
+ * @returns amount of common values written into result
+ *
+ * Inside a pair of blocks every step advances the lower side and writes the value
+ * unconditionally, so the merge has no branch that depends on the data
+ */
+static int merge_compressed_lists(const CompressedList *first, const CompressedList *second, int *result, int size)
+{
+  CompressedListIterator first_iterator;
+  CompressedListIterator second_iterator;
+  int found_values = 0;
+
+  init_compressed_list_iterator(&first_iterator, first);
+  init_compressed_list_iterator(&second_iterator, second);
+
+  while (found_values < size)
+  {
+    /**
+     * 1) Refills the side whose block is over. Its first value is only needed to skip blocks
+     */
+    int second_target = (second_iterator.position < second_iterator.count)
+                            ? second_iterator.values[second_iterator.position]
+                            : second_iterator.values[second_iterator.count - 1];
+
+    if (!skip_compressed_list_blocks(&first_iterator, second_target))
+    {
+      break;
+    }
+
+    if (!skip_compressed_list_blocks(&second_iterator, first_iterator.values[first_iterator.position]))
+    {
+      break;
+    }
+
+    /**
+     * 2) Merges until one of both blocks is over
+     */
+    const int *first_values = first_iterator.values;
+    const int *second_values = second_iterator.values;
+    int i = first_iterator.position;
+    int j = second_iterator.position;
+    int first_count = first_iterator.count;
+    int second_count = second_iterator.count;
+
+    int room = size - found_values;
+
+    if (room >= (first_count - i) + (second_count - j))
+    {
+      /**
+       * Every step takes at least one value, so the result can't overflow in this pair
+       */
+      while (i < first_count && j < second_count)
+      {
+        int first_value = first_values[i];
+        int second_value = second_values[j];
+
+        result[found_values] = first_value;
+        found_values += (first_value == second_value);
+        i += (first_value <= second_value);
+        j += (second_value <= first_value);
+      }
+    }
+    else
+    {
+      while (i < first_count && j < second_count && found_values < size)
+      {
+        int first_value = first_values[i];
+        int second_value = second_values[j];
+
+        result[found_values] = first_value;
+        found_values += (first_value == second_value);
+        i += (first_value <= second_value);
+        j += (second_value <= first_value);
+      }
+    }
+
+    first_iterator.position = i;
+    second_iterator.position = j;
+  }
+
+  return found_values;
+}
+
+/**
+ * @brief intersects two lists of very different sizes by seeking
+ *
+ * @param first First list
+ * @param second Second list
+ * @param result Destination array
+ * @param size Capacity of the destination array
+ *
+ * @returns amount of common values written into result
+ *
+ * Every list seeks the last value of the other one with next_geq, so blocks that fall
+ * between two common values are never decoded
+ */
+static int seek_compressed_lists(const CompressedList *first, const CompressedList *second, int *result, int size)
+{
+  CompressedListIterator first_iterator;
+  CompressedListIterator second_iterator;
+  int found_values = 0;
+  int first_value = 0;
+  int second_value = 0;
+
+  init_compressed_list_iterator(&first_iterator, first);
+  init_compressed_list_iterator(&second_iterator, second);
+
+  int first_alive = next_compressed_list_iterator(&first_iterator, &first_value);
+  int second_alive = next_compressed_list_iterator(&second_iterator, &second_value);
+
+  while (first_alive && second_alive && found_values < size)
+  {
+    /**
+     * 1) A common value moves both lists, otherwise the list that is behind jumps forward
+     */
+    if (first_value == second_value)
+    {
+      result[found_values++] = first_value;
+      first_alive = next_compressed_list_iterator(&first_iterator, &first_value);
+      second_alive = next_compressed_list_iterator(&second_iterator, &second_value);
+    }
+    else if (first_value < second_value)
+    {
+      first_alive = next_geq_compressed_list_iterator(&first_iterator, second_value, &first_value);
+    }
+    else
+    {
+      second_alive = next_geq_compressed_list_iterator(&second_iterator, first_value, &second_value);
+    }
+  }
+
+  return found_values;
+}
+
+/**
+ * @brief intersects two compressed lists
+ *
+ * @param first First list
+ * @param second Second list
+ * @param result Destination array
+ * @param size Capacity of the destination array
+ *
+ * @returns amount of common values written into result
+ *
+ * Lists of similar size are merged block by block, which reads every value once with no data
+ * dependent branches. When one list is COMPRESSED_LIST_SEEK_RATIO times longer than the other
+ * most of its blocks hold no common value, so the short list seeks into the long one instead
+ */
+int intersect_compressed_lists(const CompressedList *first, const CompressedList *second, int *result, int size)
+{
+  if (first == NULL || second == NULL || result == NULL || size <= 0)
+  {
+    return 0;
+  }
+
+  if (first->size == 0 || second->size == 0)
+  {
+    return 0;
+  }
+
+  if ((long long)first->size > (long long)second->size * COMPRESSED_LIST_SEEK_RATIO ||
+      (long long)second->size > (long long)first->size * COMPRESSED_LIST_SEEK_RATIO)
+  {
+    return seek_compressed_lists(first, second, result, size);
+  }
+
+  return merge_compressed_lists(first, second, result, size);
+}
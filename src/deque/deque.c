@@ -0,0 +1,581 @@
+#include "../../include/deque.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief rounds a capacity up to the next power of two
+ *
+ * @param capacity requested capacity
+ *
+ * @returns power of two that is equal or greater than the capacity, or 0 if it doesn't fit
+ * into an int
+ */
+static int round_deque_capacity(int capacity)
+{
+  int rounded = 1;
+
+  while (rounded < capacity)
+  {
+    if (rounded > (1 << 29))
+    {
+      return 0;
+    }
+
+    rounded <<= 1;
+  }
+
+  return rounded;
+}
+
+/**
+ * @brief init a deque
+ *
+ * @param capacity amount of elements that fit before the deque must grow
+ *
+ * @returns created deque
+ *
+ * This function allocates an empty deque. Its capacity is rounded up to a power of two
+ *
+ * Special cases:
+ *
+ * 1. If the deque can't be allocated in memory, then this function will return a null pointer
+ */
+Deque *create_deque(int capacity)
+{
+  int rounded_capacity = round_deque_capacity(capacity < 8 ? 8 : capacity);
+
+  if (rounded_capacity == 0)
+  {
+    return NULL;
+  }
+
+  Deque *new_deque = (Deque *)malloc(sizeof(Deque));
+
+  /**
+   * Security measure: if deque can't be allocated, then we must return null
+   */
+  if (new_deque == NULL)
+  {
+    return NULL;
+  }
+
+  new_deque->data = (int *)malloc(sizeof(int) * rounded_capacity);
+
+  if (new_deque->data == NULL)
+  {
+    free(new_deque);
+    return NULL;
+  }
+
+  new_deque->capacity = rounded_capacity;
+  new_deque->head = 0;
+  new_deque->size = 0;
+
+  return new_deque;
+}
+
+/**
+ * @brief frees a deque
+ *
+ * @param deque pointer to the deque variable
+ *
+ * @returns amount of elements that the deque had
+ *
+ * Special cases:
+ *
+ * 1. If given pointer or the deque are null, then this function will return 0
+ */
+int free_deque(Deque **deque)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (deque == NULL || *deque == NULL)
+  {
+    return 0;
+  }
+
+  int freed_elements = (*deque)->size;
+
+  free((*deque)->data);
+  free(*deque);
+  *deque = NULL;
+
+  return freed_elements;
+}
+
+/**
+ * @brief copies elements out of the circular buffer
+ *
+ * @param deque Target deque
+ * @param position position of the first element, relative to the head
+ * @param values destination array
+ * @param count amount of elements to copy
+ *
+ * Copies are done with at most two memcpy, one until the end of the buffer and one from
+ * its beginning
+ */
+static void copy_from_deque(Deque *deque, int position, int *values, int count)
+{
+  int start = (deque->head + position) & (deque->capacity - 1);
+  int first_part = deque->capacity - start;
+
+  if (first_part > count)
+  {
+    first_part = count;
+  }
+
+  memcpy(values, deque->data + start, sizeof(int) * first_part);
+  memcpy(values + first_part, deque->data, sizeof(int) * (count - first_part));
+}
+
+/**
+ * @brief copies elements into the circular buffer
+ *
+ * @param deque Target deque
+ * @param position position of the first element, relative to the head
+ * @param values source array
+ * @param count amount of elements to copy
+ */
+static void copy_into_deque(Deque *deque, int position, const int *values, int count)
+{
+  int start = (deque->head + position) & (deque->capacity - 1);
+  int first_part = deque->capacity - start;
+
+  if (first_part > count)
+  {
+    first_part = count;
+  }
+
+  memcpy(deque->data + start, values, sizeof(int) * first_part);
+  memcpy(deque->data, values + first_part, sizeof(int) * (count - first_part));
+}
+
+/**
+ * @brief makes room for more elements
+ *
+ * @param deque Target deque
+ * @param extra amount of elements that will be added
+ *
+ * @returns 1 if the elements fit, otherwise 0
+ *
+ * The capacity is doubled until the elements fit, and the elements are moved to the
+ * beginning of the new buffer
+ */
+static int reserve_deque(Deque *deque, int extra)
+{
+  if (deque->capacity - deque->size >= extra)
+  {
+    return 1;
+  }
+
+  if (extra > (1 << 30) - deque->size)
+  {
+    return 0;
+  }
+
+  int new_capacity = round_deque_capacity(deque->size + extra);
+
+  if (new_capacity == 0)
+  {
+    return 0;
+  }
+
+  int *new_data = (int *)malloc(sizeof(int) * new_capacity);
+
+  /**
+   * Security measure: if the new buffer can't be allocated, then the deque is kept as it was
+   */
+  if (new_data == NULL)
+  {
+    return 0;
+  }
+
+  copy_from_deque(deque, 0, new_data, deque->size);
+  free(deque->data);
+
+  deque->data = new_data;
+  deque->capacity = new_capacity;
+  deque->head = 0;
+
+  return 1;
+}
+
+/**
+ * @brief adds an element at the end of a deque
+ *
+ * @param deque Target deque
+ * @param data value of the new element
+ *
+ * @returns amount of added elements during the operation
+ *
+ * Special cases:
+ *
+ * 1. If deque is a null pointer or it can't grow, then this function will return 0
+ */
+int push_back_deque(Deque *deque, int data)
+{
+  if (deque == NULL || !reserve_deque(deque, 1))
+  {
+    return 0;
+  }
+
+  deque->data[(deque->head + deque->size) & (deque->capacity - 1)] = data;
+  deque->size++;
+
+  return 1;
+}
+
+/**
+ * @brief adds an element at the beginning of a deque
+ *
+ * @param deque Target deque
+ * @param data value of the new element
+ *
+ * @returns amount of added elements during the operation
+ *
+ * Special cases:
+ *
+ * 1. If deque is a null pointer or it can't grow, then this function will return 0
+ */
+int push_front_deque(Deque *deque, int data)
+{
+  if (deque == NULL || !reserve_deque(deque, 1))
+  {
+    return 0;
+  }
+
+  deque->head = (deque->head - 1) & (deque->capacity - 1);
+  deque->data[deque->head] = data;
+  deque->size++;
+
+  return 1;
+}
+
+/**
+ * @brief removes the last element of a deque
+ *
+ * @param deque Target deque
+ * @param data variable where the removed value is stored, it can be null
+ *
+ * @returns amount of removed elements during the operation
+ *
+ * Special cases:
+ *
+ * 1. If deque is a null pointer or it's empty, then this function will return 0
+ */
+int pop_back_deque(Deque *deque, int *data)
+{
+  if (deque == NULL || deque->size == 0)
+  {
+    return 0;
+  }
+
+  deque->size--;
+
+  if (data != NULL)
+  {
+    *data = deque->data[(deque->head + deque->size) & (deque->capacity - 1)];
+  }
+
+  return 1;
+}
+
+/**
+ * @brief removes the first element of a deque
+ *
+ * @param deque Target deque
+ * @param data variable where the removed value is stored, it can be null
+ *
+ * @returns amount of removed elements during the operation
+ *
+ * Special cases:
+ *
+ * 1. If deque is a null pointer or it's empty, then this function will return 0
+ */
+int pop_front_deque(Deque *deque, int *data)
+{
+  if (deque == NULL || deque->size == 0)
+  {
+    return 0;
+  }
+
+  if (data != NULL)
+  {
+    *data = deque->data[deque->head];
+  }
+
+  deque->head = (deque->head + 1) & (deque->capacity - 1);
+  deque->size--;
+
+  return 1;
+}
+
+/**
+ * @brief reads the last element of a deque without removing it
+ *
+ * @param deque Target deque
+ * @param data variable where the value is stored
+ *
+ * @returns 1 if there was an element to read, otherwise 0
+ */
+int peek_back_deque(Deque *deque, int *data)
+{
+  if (deque == NULL || data == NULL || deque->size == 0)
+  {
+    return 0;
+  }
+
+  *data = deque->data[(deque->head + deque->size - 1) & (deque->capacity - 1)];
+
+  return 1;
+}
+
+/**
+ * @brief reads the first element of a deque without removing it
+ *
+ * @param deque Target deque
+ * @param data variable where the value is stored
+ *
+ * @returns 1 if there was an element to read, otherwise 0
+ */
+int peek_front_deque(Deque *deque, int *data)
+{
+  if (deque == NULL || data == NULL || deque->size == 0)
+  {
+    return 0;
+  }
+
+  *data = deque->data[deque->head];
+
+  return 1;
+}
+
+/**
+ * @brief adds several elements at the end of a deque
+ *
+ * @param deque Target deque
+ * @param values array with the new values, in order
+ * @param count amount of values
+ *
+ * @returns amount of added elements during the operation
+ *
+ * The deque grows at most once and the values are copied with at most two memcpy
+ *
+ * Special cases:
+ *
+ * 1. If the deque can't grow, then no value is added and this function will return 0
+ */
+int enqueue_deque(Deque *deque, const int *values, int count)
+{
+  if (deque == NULL || values == NULL || count <= 0 || !reserve_deque(deque, count))
+  {
+    return 0;
+  }
+
+  copy_into_deque(deque, deque->size, values, count);
+  deque->size += count;
+
+  return count;
+}
+
+/**
+ * @brief removes several elements from the beginning of a deque
+ *
+ * @param deque Target deque
+ * @param values array where the removed values are stored, in order
+ * @param count maximum amount of values to remove
+ *
+ * @returns amount of removed elements during the operation
+ */
+int dequeue_deque(Deque *deque, int *values, int count)
+{
+  if (deque == NULL || values == NULL || count <= 0)
+  {
+    return 0;
+  }
+
+  if (count > deque->size)
+  {
+    count = deque->size;
+  }
+
+  copy_from_deque(deque, 0, values, count);
+  deque->head = (deque->head + count) & (deque->capacity - 1);
+  deque->size -= count;
+
+  return count;
+}
+
+/**
+ * @brief init a single producer / single consumer queue
+ *
+ * @param capacity maximum amount of elements, it's rounded up to a power of two
+ *
+ * @returns created queue
+ *
+ * This queue never grows, so neither side ever waits for the other one: enqueue and
+ * dequeue just move as many elements as they can and return
+ *
+ * Special cases:
+ *
+ * 1. If the queue can't be allocated in memory, then this function will return a null pointer
+ */
+SpscQueue *create_spsc_queue(int capacity)
+{
+  int rounded_capacity = round_deque_capacity(capacity < 2 ? 2 : capacity);
+
+  if (rounded_capacity == 0)
+  {
+    return NULL;
+  }
+
+  /**
+   * 1) The queue is aligned to a cache line so head and tail never share one
+   */
+  SpscQueue *new_queue = (SpscQueue *)aligned_alloc(alignof(SpscQueue), sizeof(SpscQueue));
+
+  if (new_queue == NULL)
+  {
+    return NULL;
+  }
+
+  new_queue->data = (int *)malloc(sizeof(int) * rounded_capacity);
+
+  if (new_queue->data == NULL)
+  {
+    free(new_queue);
+    return NULL;
+  }
+
+  new_queue->capacity = (unsigned int)rounded_capacity;
+  atomic_init(&new_queue->head, 0);
+  atomic_init(&new_queue->tail, 0);
+
+  return new_queue;
+}
+
+/**
+ * @brief frees a single producer / single consumer queue
+ *
+ * @param queue pointer to the queue variable
+ *
+ * @returns amount of elements that the queue had
+ *
+ * No thread may use the queue during or after this call
+ */
+int free_spsc_queue(SpscQueue **queue)
+{
+  if (queue == NULL || *queue == NULL)
+  {
+    return 0;
+  }
+
+  int freed_elements = (int)(atomic_load(&(*queue)->tail) - atomic_load(&(*queue)->head));
+
+  free((*queue)->data);
+  free(*queue);
+  *queue = NULL;
+
+  return freed_elements;
+}
+
+/**
+ * @brief adds elements to a single producer / single consumer queue
+ *
+ * @param queue Target queue
+ * @param values array with the new values, in order
+ * @param count amount of values
+ *
+ * @returns amount of added elements, it's less than count when the queue is full
+ *
+ * Only the producer thread may call this function. head and tail are counters that wrap
+ * around, so their difference is always the amount of elements in the queue
+ */
+int enqueue_spsc_queue(SpscQueue *queue, const int *values, int count)
+{
+  if (queue == NULL || values == NULL || count <= 0)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) tail is ours, head is published by the consumer after it has read the elements
+   */
+  unsigned int tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+  unsigned int head = atomic_load_explicit(&queue->head, memory_order_acquire);
+  unsigned int free_slots = queue->capacity - (tail - head);
+
+  if ((unsigned int)count > free_slots)
+  {
+    count = (int)free_slots;
+  }
+
+  /**
+   * 2) Copies the values and publishes them by moving the tail
+   */
+  unsigned int start = tail & (queue->capacity - 1);
+  unsigned int first_part = queue->capacity - start;
+
+  if (first_part > (unsigned int)count)
+  {
+    first_part = (unsigned int)count;
+  }
+
+  memcpy(queue->data + start, values, sizeof(int) * first_part);
+  memcpy(queue->data, values + first_part, sizeof(int) * (count - first_part));
+
+  atomic_store_explicit(&queue->tail, tail + (unsigned int)count, memory_order_release);
+
+  return count;
+}
+
+/**
+ * @brief removes elements from a single producer / single consumer queue
+ *
+ * @param queue Target queue
+ * @param values array where the removed values are stored, in order
+ * @param count maximum amount of values to remove
+ *
+ * @returns amount of removed elements, it's less than count when the queue runs out
+ *
+ * Only the consumer thread may call this function
+ */
+int dequeue_spsc_queue(SpscQueue *queue, int *values, int count)
+{
+  if (queue == NULL || values == NULL || count <= 0)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) head is ours, tail is published by the producer after it has written the elements
+   */
+  unsigned int head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+  unsigned int tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+  unsigned int available = tail - head;
+
+  if ((unsigned int)count > available)
+  {
+    count = (int)available;
+  }
+
+  /**
+   * 2) Copies the values and gives their slots back by moving the head
+   */
+  unsigned int start = head & (queue->capacity - 1);
+  unsigned int first_part = queue->capacity - start;
+
+  if (first_part > (unsigned int)count)
+  {
+    first_part = (unsigned int)count;
+  }
+
+  memcpy(values, queue->data + start, sizeof(int) * first_part);
+  memcpy(values + first_part, queue->data, sizeof(int) * (count - first_part));
+
+  atomic_store_explicit(&queue->head, head + (unsigned int)count, memory_order_release);
+
+  return count;
+}
@@ -0,0 +1,563 @@
+#include "../../include/heap.h"
+
+#include <stdlib.h>
+
+/**
+ * @brief checks if a value must be closer to the root than another one
+ *
+ * @param heap Target heap
+ * @param first first value
+ * @param second second value
+ *
+ * @returns 1 if first goes before second, otherwise 0
+ */
+static inline int heap_goes_before(const Heap *heap, int first, int second)
+{
+  return (heap->order == MIN_HEAP) ? first < second : first > second;
+}
+
+/**
+ * @brief init a heap
+ *
+ * @param order MIN_HEAP to keep the smallest value at the root, MAX_HEAP for the greatest
+ * @param arity amount of children of every node, 0 takes HEAP_DEFAULT_ARITY
+ *
+ * @returns created heap
+ *
+ * Special cases:
+ *
+ * 1. If the heap can't be allocated in memory, then this function will return a null pointer
+ */
+Heap *create_heap(HeapOrder order, int arity)
+{
+  Heap *new_heap = (Heap *)malloc(sizeof(Heap));
+
+  /**
+   * Security measure: if heap can't be allocated, then we must return null
+   */
+  if (new_heap == NULL)
+  {
+    return NULL;
+  }
+
+  new_heap->entries = NULL;
+  new_heap->size = 0;
+  new_heap->capacity = 0;
+  new_heap->arity = (arity < 2) ? HEAP_DEFAULT_ARITY : arity;
+  new_heap->order = order;
+  new_heap->positions = NULL;
+  new_heap->handles_count = 0;
+  new_heap->handles_capacity = 0;
+  new_heap->free_handles = NULL;
+  new_heap->free_handles_size = 0;
+
+  return new_heap;
+}
+
+/**
+ * @brief frees a heap
+ *
+ * @param heap pointer to the heap variable
+ *
+ * @returns amount of elements that the heap had
+ */
+int free_heap(Heap **heap)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (heap == NULL || *heap == NULL)
+  {
+    return 0;
+  }
+
+  int freed_elements = (*heap)->size;
+
+  free((*heap)->entries);
+  free((*heap)->positions);
+  free((*heap)->free_handles);
+  free(*heap);
+  *heap = NULL;
+
+  return freed_elements;
+}
+
+/**
+ * @brief makes room for more entries and handles
+ *
+ * @param heap Target heap
+ * @param capacity amount of entries that must fit
+ *
+ * @returns 1 if the entries fit, otherwise 0
+ */
+static int reserve_heap(Heap *heap, int capacity)
+{
+  if (capacity <= heap->capacity)
+  {
+    return 1;
+  }
+
+  int new_capacity = (heap->capacity < 16) ? 16 : heap->capacity;
+
+  while (new_capacity < capacity)
+  {
+    new_capacity *= 2;
+  }
+
+  HeapEntry *new_entries = (HeapEntry *)realloc(heap->entries, sizeof(HeapEntry) * new_capacity);
+
+  if (new_entries == NULL)
+  {
+    return 0;
+  }
+
+  heap->entries = new_entries;
+  heap->capacity = new_capacity;
+
+  return 1;
+}
+
+/**
+ * @brief takes a handle for a new element
+ *
+ * @param heap Target heap
+ *
+ * @returns free handle, or -1 if memory can't be allocated
+ *
+ * Handles of popped elements are given again before new ones are created
+ */
+static int take_heap_handle(Heap *heap)
+{
+  if (heap->free_handles_size > 0)
+  {
+    return heap->free_handles[--heap->free_handles_size];
+  }
+
+  if (heap->handles_count == heap->handles_capacity)
+  {
+    int new_capacity = (heap->handles_capacity < 16) ? 16 : heap->handles_capacity * 2;
+    int *new_positions = (int *)realloc(heap->positions, sizeof(int) * new_capacity);
+
+    if (new_positions == NULL)
+    {
+      return -1;
+    }
+
+    heap->positions = new_positions;
+
+    int *new_free_handles = (int *)realloc(heap->free_handles, sizeof(int) * new_capacity);
+
+    if (new_free_handles == NULL)
+    {
+      return -1;
+    }
+
+    heap->free_handles = new_free_handles;
+    heap->handles_capacity = new_capacity;
+  }
+
+  return heap->handles_count++;
+}
+
+/**
+ * @brief moves an entry up until its parent goes before it
+ *
+ * @param heap Target heap
+ * @param index position of the entry
+ *
+ * The entry is kept aside and parents are moved down, so every level costs one copy
+ */
+static void sift_up_heap(Heap *heap, int index)
+{
+  HeapEntry entry = heap->entries[index];
+
+  while (index > 0)
+  {
+    int parent = (index - 1) / heap->arity;
+
+    if (!heap_goes_before(heap, entry.data, heap->entries[parent].data))
+    {
+      break;
+    }
+
+    heap->entries[index] = heap->entries[parent];
+    heap->positions[heap->entries[index].handle] = index;
+    index = parent;
+  }
+
+  heap->entries[index] = entry;
+  heap->positions[entry.handle] = index;
+}
+
+/**
+ * @brief moves an entry down until it goes before all its children
+ *
+ * @param heap Target heap
+ * @param index position of the entry
+ */
+static void sift_down_heap(Heap *heap, int index)
+{
+  HeapEntry entry = heap->entries[index];
+
+  while (1)
+  {
+    /**
+     * 1) Looks for the child that must be closer to the root
+     */
+    int first_child = heap->arity * index + 1;
+
+    if (first_child >= heap->size)
+    {
+      break;
+    }
+
+    int last_child = first_child + heap->arity;
+
+    if (last_child > heap->size)
+    {
+      last_child = heap->size;
+    }
+
+    int best_child = first_child;
+
+    for (int child = first_child + 1; child < last_child; child++)
+    {
+      if (heap_goes_before(heap, heap->entries[child].data, heap->entries[best_child].data))
+      {
+        best_child = child;
+      }
+    }
+
+    /**
+     * 2) Stops when the entry already goes before that child, otherwise the child goes up
+     */
+    if (!heap_goes_before(heap, heap->entries[best_child].data, entry.data))
+    {
+      break;
+    }
+
+    heap->entries[index] = heap->entries[best_child];
+    heap->positions[heap->entries[index].handle] = index;
+    index = best_child;
+  }
+
+  heap->entries[index] = entry;
+  heap->positions[entry.handle] = index;
+}
+
+/**
+ * @brief builds a heap from an array in O(n)
+ *
+ * @param values array with the values
+ * @param count amount of values
+ * @param order MIN_HEAP or MAX_HEAP
+ * @param arity amount of children of every node, 0 takes HEAP_DEFAULT_ARITY
+ *
+ * @returns created heap
+ *
+ * The value at position i of the array gets the handle i. Entries are sifted down from the
+ * last parent to the root, which is cheaper than pushing them one by one
+ *
+ * Special cases:
+ *
+ * 1. If memory can't be allocated, then this function will return a null pointer
+ */
+Heap *heapify_array(const int *values, int count, HeapOrder order, int arity)
+{
+  Heap *new_heap = create_heap(order, arity);
+
+  if (new_heap == NULL || count <= 0 || values == NULL)
+  {
+    return new_heap;
+  }
+
+  /**
+   * 1) Reserves entries and handles for every value at once
+   */
+  new_heap->positions = (int *)malloc(sizeof(int) * count);
+  new_heap->free_handles = (int *)malloc(sizeof(int) * count);
+
+  if (new_heap->positions == NULL || new_heap->free_handles == NULL || !reserve_heap(new_heap, count))
+  {
+    free_heap(&new_heap);
+    return NULL;
+  }
+
+  new_heap->handles_capacity = count;
+  new_heap->handles_count = count;
+
+  for (int i = 0; i < count; i++)
+  {
+    new_heap->entries[i].data = values[i];
+    new_heap->entries[i].handle = i;
+    new_heap->positions[i] = i;
+  }
+
+  new_heap->size = count;
+
+  /**
+   * 2) Leaves are already heaps, so only parents must be sifted down
+   */
+  for (int i = (count - 2) / new_heap->arity; i >= 0; i--)
+  {
+    sift_down_heap(new_heap, i);
+  }
+
+  return new_heap;
+}
+
+/**
+ * @brief adds a value to a heap
+ *
+ * @param heap Target heap
+ * @param data value to add
+ *
+ * @returns handle of the new element, or -1 if it can't be added
+ *
+ * The handle can be given to update_heap_key until the element is popped. After that the
+ * same handle may be given to a new element
+ */
+int push_heap(Heap *heap, int data)
+{
+  if (heap == NULL || !reserve_heap(heap, heap->size + 1))
+  {
+    return -1;
+  }
+
+  int handle = take_heap_handle(heap);
+
+  if (handle < 0)
+  {
+    return -1;
+  }
+
+  heap->entries[heap->size].data = data;
+  heap->entries[heap->size].handle = handle;
+  heap->size++;
+
+  sift_up_heap(heap, heap->size - 1);
+
+  return handle;
+}
+
+/**
+ * @brief removes the root of a heap
+ *
+ * @param heap Target heap
+ * @param data variable where the removed value is stored, it can be null
+ *
+ * @returns amount of removed elements during the operation
+ *
+ * The root is the smallest value of a MIN_HEAP and the greatest value of a MAX_HEAP
+ */
+int pop_heap(Heap *heap, int *data)
+{
+  if (heap == NULL || heap->size == 0)
+  {
+    return 0;
+  }
+
+  HeapEntry root = heap->entries[0];
+
+  if (data != NULL)
+  {
+    *data = root.data;
+  }
+
+  /**
+   * 1) The handle of the root can be given again
+   */
+  heap->positions[root.handle] = -1;
+  heap->free_handles[heap->free_handles_size++] = root.handle;
+
+  /**
+   * 2) The last entry takes the place of the root and goes down
+   */
+  heap->size--;
+
+  if (heap->size > 0)
+  {
+    heap->entries[0] = heap->entries[heap->size];
+    sift_down_heap(heap, 0);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief reads the root of a heap without removing it
+ *
+ * @param heap Target heap
+ * @param data variable where the value is stored
+ *
+ * @returns 1 if there was an element to read, otherwise 0
+ */
+int peek_heap(Heap *heap, int *data)
+{
+  if (heap == NULL || data == NULL || heap->size == 0)
+  {
+    return 0;
+  }
+
+  *data = heap->entries[0].data;
+
+  return 1;
+}
+
+/**
+ * @brief changes the value of an element
+ *
+ * @param heap Target heap
+ * @param handle handle returned when the element was pushed
+ * @param data new value
+ *
+ * @returns amount of updated elements during the operation
+ *
+ * Moving a value towards the root (decrease-key on a MIN_HEAP) costs one sift up. The other
+ * direction is supported too and costs one sift down
+ *
+ * Special cases:
+ *
+ * 1. If the handle doesn't belong to an element of the heap, then this function will return 0
+ */
+int update_heap_key(Heap *heap, int handle, int data)
+{
+  if (heap == NULL || handle < 0 || handle >= heap->handles_count || heap->positions[handle] < 0)
+  {
+    return 0;
+  }
+
+  int index = heap->positions[handle];
+  int old_data = heap->entries[index].data;
+
+  heap->entries[index].data = data;
+
+  if (heap_goes_before(heap, data, old_data))
+  {
+    sift_up_heap(heap, index);
+  }
+  else
+  {
+    sift_down_heap(heap, index);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief offers a value to a heap that keeps the best k values of a stream
+ *
+ * @param heap Heap that stores the selection
+ * @param k amount of values to keep
+ * @param data offered value
+ *
+ * @returns handle of the kept value, or -1 if it wasn't kept
+ *
+ * A MIN_HEAP keeps the k greatest values and a MAX_HEAP the k smallest ones. The root is
+ * always the worst selected value, so a value that doesn't improve the selection is rejected
+ * with a single comparison. The evicted root stops being in the heap, so its handle is
+ * released like on pop_heap and the kept value gets another one
+ */
+int offer_heap_top_k(Heap *heap, int k, int data)
+{
+  if (heap == NULL || k <= 0)
+  {
+    return -1;
+  }
+
+  /**
+   * 1) While there's room every value is kept
+   */
+  if (heap->size < k)
+  {
+    return push_heap(heap, data);
+  }
+
+  /**
+   * 2) Otherwise the value replaces the root only when it's better
+   */
+  if (!heap_goes_before(heap, heap->entries[0].data, data))
+  {
+    return -1;
+  }
+
+  /**
+   * 3) The new handle is taken before releasing the old one, so they can't be the same
+   */
+  int handle = take_heap_handle(heap);
+
+  if (handle < 0)
+  {
+    return -1;
+  }
+
+  heap->positions[heap->entries[0].handle] = -1;
+  heap->free_handles[heap->free_handles_size++] = heap->entries[0].handle;
+
+  heap->entries[0].data = data;
+  heap->entries[0].handle = handle;
+  sift_down_heap(heap, 0);
+
+  return handle;
+}
+
+/**
+ * @brief selects the k greatest values of an array
+ *
+ * @param values array with the values
+ * @param count amount of values
+ * @param k amount of values to select
+ * @param result array with room for k values, they are stored from the greatest
+ *
+ * @returns amount of selected values, or -1 if memory can't be allocated
+ *
+ * This function runs in O(n log k) and only needs memory for k values
+ */
+int select_top_k(const int *values, int count, int k, int *result)
+{
+  if (values == NULL || result == NULL || count <= 0 || k <= 0)
+  {
+    return 0;
+  }
+
+  Heap *heap = create_heap(MIN_HEAP, 0);
+
+  if (heap == NULL || !reserve_heap(heap, k))
+  {
+    free_heap(&heap);
+    return -1;
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    /**
+     * 1) The first k values fill the heap, every value after them is offered
+     */
+    if (heap->size < k)
+    {
+      if (push_heap(heap, values[i]) < 0)
+      {
+        free_heap(&heap);
+        return -1;
+      }
+
+      continue;
+    }
+
+    offer_heap_top_k(heap, k, values[i]);
+  }
+
+  /**
+   * 2) Popping a MIN_HEAP gives the values from the smallest, so they are stored backwards
+   */
+  int selected = heap->size;
+
+  for (int i = selected - 1; i >= 0; i--)
+  {
+    pop_heap(heap, &result[i]);
+  }
+
+  free_heap(&heap);
+
+  return selected;
+}
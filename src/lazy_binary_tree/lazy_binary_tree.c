@@ -0,0 +1,610 @@
+#include "../../include/lazy_binary_tree.h"
+
+#include <stdlib.h>
+
+/**
+ * @brief walks down to the first live node that stores given data
+ *
+ * @param node Lazy binary tree head
+ * @param data value to search
+ *
+ * @returns found node or a null pointer
+ *
+ * Equal values are always at the right side, so a dead node with the searched value only
+ * means that a live duplicate could still be found below its right side
+ */
+static LazyBinaryTreeNode *find_live_lazy_binary_tree_node(LazyBinaryTreeNode *node, int data)
+{
+  while (node != NULL)
+  {
+    if (node->data == data && !node->deleted)
+    {
+      return node;
+    }
+
+    node = data < node->data ? node->left : node->right;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief relinks a sorted array of nodes as a balanced tree
+ *
+ * @param nodes sorted live nodes
+ * @param size amount of nodes
+ *
+ * @returns head of the relinked tree
+ *
+ * The root of every range is the first copy of its middle value, so equal values stay at the
+ * right side and searches keep finding them. Left ranges are at most half of their parent and
+ * are linked recursively, right ranges are linked by the loop, so the recursion depth is
+ * log2(size) even with long runs of equal values
+ */
+static LazyBinaryTreeNode *link_balanced_lazy_binary_tree(LazyBinaryTreeNode **nodes, int size)
+{
+  LazyBinaryTreeNode *head = NULL;
+  LazyBinaryTreeNode **slot = &head;
+
+  while (size > 0)
+  {
+    int middle = size / 2;
+    int low = 0;
+
+    /**
+     * Binary search for the first copy, a long run of equal values would make a backwards
+     * scan cost its length on every node of the run
+     */
+    while (low < middle)
+    {
+      int probe = low + (middle - low) / 2;
+
+      if (nodes[probe]->data < nodes[middle]->data)
+      {
+        low = probe + 1;
+      }
+      else
+      {
+        middle = probe;
+      }
+    }
+
+    LazyBinaryTreeNode *node = nodes[middle];
+    node->left = link_balanced_lazy_binary_tree(nodes, middle);
+    node->nodes = size;
+    node->dead_nodes = 0;
+
+    *slot = node;
+    slot = &node->right;
+    nodes += middle + 1;
+    size -= middle + 1;
+  }
+
+  *slot = NULL;
+
+  return head;
+}
+
+/**
+ * @brief frees the dead nodes of a subtree and relinks the live ones balanced
+ *
+ * @param slot pointer to the link that holds the subtree
+ *
+ * @returns amount of freed nodes or -1 if the traversal buffers can't be allocated
+ *
+ * Live nodes are reused, so their addresses stay valid. Subtrees of up to
+ * LAZY_BINARY_TREE_MAX_REBUILD nodes use buffers on the call stack, so compacting them on
+ * the path of a delete never allocates
+ *
+ * Special cases:
+ *
+ * 1. If the buffers can't be allocated, the subtree is left untouched and still correct
+ */
+static int rebuild_lazy_binary_subtree(LazyBinaryTreeNode **slot)
+{
+  LazyBinaryTreeNode *local_stack[LAZY_BINARY_TREE_MAX_REBUILD];
+  LazyBinaryTreeNode *local_live_nodes[LAZY_BINARY_TREE_MAX_REBUILD];
+  LazyBinaryTreeNode **stack = local_stack;
+  LazyBinaryTreeNode **live_nodes = local_live_nodes;
+  int total_nodes = (*slot)->nodes;
+
+  /**
+   * 1) The height of the subtree can't be greater than its amount of nodes
+   */
+  if (total_nodes > LAZY_BINARY_TREE_MAX_REBUILD)
+  {
+    stack = (LazyBinaryTreeNode **)malloc(sizeof(LazyBinaryTreeNode *) * total_nodes);
+    live_nodes = (LazyBinaryTreeNode **)malloc(sizeof(LazyBinaryTreeNode *) * total_nodes);
+
+    /**
+     * Security measure: if buffers can't be allocated, then we must return -1
+     */
+    if (stack == NULL || live_nodes == NULL)
+    {
+      free(stack);
+      free(live_nodes);
+      return -1;
+    }
+  }
+
+  /**
+   * 2) In-order traversal collects live nodes sorted and frees the dead ones once their right
+   * side has been read
+   */
+  int stack_size = 0;
+  int live_count = 0;
+  int freed_nodes = 0;
+  LazyBinaryTreeNode *current_node = *slot;
+
+  while (current_node != NULL || stack_size > 0)
+  {
+    while (current_node != NULL)
+    {
+      stack[stack_size++] = current_node;
+      current_node = current_node->left;
+    }
+
+    LazyBinaryTreeNode *visited_node = stack[--stack_size];
+    current_node = visited_node->right;
+
+    if (visited_node->deleted)
+    {
+      free(visited_node);
+      freed_nodes++;
+    }
+    else
+    {
+      live_nodes[live_count++] = visited_node;
+    }
+  }
+
+  /**
+   * 3) Relinks the survivors as a balanced subtree
+   */
+  *slot = link_balanced_lazy_binary_tree(live_nodes, live_count);
+
+  if (stack != local_stack)
+  {
+    free(stack);
+    free(live_nodes);
+  }
+
+  return freed_nodes;
+}
+
+/**
+ * @brief compacts a dead-heavy subtree found on the path of a delete
+ *
+ * @param tree Target tree
+ * @param slot link to the subtree to rebuild
+ * @param data deleted value, it leads from the root to the subtree
+ *
+ * Rebuilding only lowers the ratio of the subtrees above it, so their counters are fixed on
+ * a second walk from the root
+ */
+static void compact_lazy_binary_subtree(LazyBinaryTree *tree, LazyBinaryTreeNode **slot, int data)
+{
+  int freed_nodes = rebuild_lazy_binary_subtree(slot);
+
+  if (freed_nodes <= 0)
+  {
+    return;
+  }
+
+  for (LazyBinaryTreeNode **ancestor = &tree->head; ancestor != slot;)
+  {
+    LazyBinaryTreeNode *node = *ancestor;
+
+    node->nodes -= freed_nodes;
+    node->dead_nodes -= freed_nodes;
+    ancestor = data < node->data ? &node->left : &node->right;
+  }
+}
+
+/**
+ * @brief init an empty lazy binary tree
+ *
+ * @param tree Target tree
+ * @param compaction_threshold fraction of dead nodes that makes a subtree be compacted, 0 disables it
+ *
+ * Without automatic compaction the caller decides when compact_lazy_binary_tree runs, for
+ * example between bursts of deletes
+ */
+void init_lazy_binary_tree(LazyBinaryTree *tree, double compaction_threshold)
+{
+  /**
+   * Security measure: if given tree is a null pointer, then we must return
+   */
+  if (tree == NULL)
+  {
+    return;
+  }
+
+  tree->head = NULL;
+  tree->compaction_threshold = compaction_threshold;
+}
+
+/**
+ * @brief inserts a value into a lazy binary tree
+ *
+ * @param tree Target tree
+ * @param data value of the new node
+ *
+ * @returns amount of inserted values (in this case can be only 1 or 0)
+ *
+ * A dead node with the same value on the search path is revived instead of allocating a new one
+ *
+ * Special cases:
+ *
+ * 1. If given tree is a null pointer or the new node can't be allocated, then this function will return 0
+ */
+int insert_lazy_binary_tree_node(LazyBinaryTree *tree, int data)
+{
+  /**
+   * Security measure: if given tree is a null pointer, then we must return 0
+   */
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) Follows the insertion path looking for a tombstone to revive
+   */
+  LazyBinaryTreeNode *node = tree->head;
+
+  while (node != NULL && !(node->data == data && node->deleted))
+  {
+    node = data < node->data ? node->left : node->right;
+  }
+
+  if (node != NULL)
+  {
+    for (LazyBinaryTreeNode *ancestor = tree->head; ancestor != node;)
+    {
+      ancestor->dead_nodes--;
+      ancestor = data < ancestor->data ? ancestor->left : ancestor->right;
+    }
+
+    node->dead_nodes--;
+    node->deleted = 0;
+
+    return 1;
+  }
+
+  /**
+   * 2) Otherwise a new node is linked as a leaf, and every node on the way gets one more node
+   */
+  LazyBinaryTreeNode *new_node = (LazyBinaryTreeNode *)malloc(sizeof(LazyBinaryTreeNode));
+
+  /**
+   * Security measure: if this node can't be allocated, then we must return 0
+   */
+  if (new_node == NULL)
+  {
+    return 0;
+  }
+
+  new_node->data = data;
+  new_node->deleted = 0;
+  new_node->nodes = 1;
+  new_node->dead_nodes = 0;
+  new_node->left = NULL;
+  new_node->right = NULL;
+
+  LazyBinaryTreeNode **slot = &tree->head;
+
+  while (*slot != NULL)
+  {
+    (*slot)->nodes++;
+    slot = data < (*slot)->data ? &(*slot)->left : &(*slot)->right;
+  }
+
+  *slot = new_node;
+
+  return 1;
+}
+
+/**
+ * @brief marks a node of a lazy binary tree as deleted
+ *
+ * @param tree Target tree
+ * @param data value to delete
+ *
+ * @returns amount of deleted values (in this case can be only 1 or 0)
+ *
+ * The tombstone is left in a single walk from the root. Nothing is relinked unless a subtree
+ * on the path of at least LAZY_BINARY_TREE_MIN_REBUILD and at most
+ * LAZY_BINARY_TREE_MAX_REBUILD nodes reaches the compaction threshold. Then the highest one is
+ * rebuilt, so deleting costs at most the height of the tree twice plus
+ * LAZY_BINARY_TREE_MAX_REBUILD nodes. Since a subtree needs as many new tombstones as its
+ * threshold of nodes before it is rebuilt again, that cost is spread over those deletes
+ *
+ * Special cases:
+ *
+ * 1. If given tree is a null pointer or the value isn't stored, then this function will return 0
+ */
+int delete_lazy_binary_tree_node(LazyBinaryTree *tree, int data)
+{
+  /**
+   * Security measure: if given tree is a null pointer, then we must return 0
+   */
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) Every subtree on the way to the first live copy gets one more dead node, and the
+   * highest one that is big and dead enough to be compacted is remembered
+   */
+  LazyBinaryTreeNode **slot = &tree->head;
+  LazyBinaryTreeNode **compacted_slot = NULL;
+
+  while (*slot != NULL)
+  {
+    LazyBinaryTreeNode *node = *slot;
+    node->dead_nodes++;
+
+    if (compacted_slot == NULL && tree->compaction_threshold > 0 && node->nodes >= LAZY_BINARY_TREE_MIN_REBUILD &&
+        node->nodes <= LAZY_BINARY_TREE_MAX_REBUILD && node->dead_nodes >= tree->compaction_threshold * node->nodes)
+    {
+      compacted_slot = slot;
+    }
+
+    if (node->data == data && !node->deleted)
+    {
+      break;
+    }
+
+    slot = data < node->data ? &node->left : &node->right;
+  }
+
+  /**
+   * 2) A missing value gives back the dead nodes counted on the way
+   */
+  if (*slot == NULL)
+  {
+    for (LazyBinaryTreeNode *node = tree->head; node != NULL; node = data < node->data ? node->left : node->right)
+    {
+      node->dead_nodes--;
+    }
+
+    return 0;
+  }
+
+  (*slot)->deleted = 1;
+
+  /**
+   * 3) Compacts the remembered subtree, if any
+   */
+  if (compacted_slot != NULL)
+  {
+    compact_lazy_binary_subtree(tree, compacted_slot, data);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief finds a live node of a lazy binary tree
+ *
+ * @param tree Target tree
+ * @param data value to search
+ *
+ * @returns found node or a null pointer
+ *
+ * Special cases:
+ *
+ * 1. If given tree is a null pointer, then this function will return a null pointer
+ */
+LazyBinaryTreeNode *find_lazy_binary_tree_node(LazyBinaryTree *tree, int data)
+{
+  /**
+   * Security measure: if given tree is a null pointer, then we must return null
+   */
+  if (tree == NULL)
+  {
+    return NULL;
+  }
+
+  return find_live_lazy_binary_tree_node(tree->head, data);
+}
+
+/**
+ * @brief frees every node of a lazy binary tree, dead or alive
+ *
+ * @param tree Target tree
+ *
+ * @returns amount of freed nodes
+ *
+ * Left children are rotated to the right before freeing, so no stack is needed
+ *
+ * Special cases:
+ *
+ * 1. If given tree is a null pointer, then this function will return 0
+ */
+int free_lazy_binary_tree(LazyBinaryTree *tree)
+{
+  /**
+   * Security measure: if given tree is a null pointer, then we must return 0
+   */
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  int freed_nodes = 0;
+  LazyBinaryTreeNode *current_node = tree->head;
+
+  while (current_node != NULL)
+  {
+    if (current_node->left != NULL)
+    {
+      LazyBinaryTreeNode *left_node = current_node->left;
+      current_node->left = left_node->right;
+      left_node->right = current_node;
+      current_node = left_node;
+      continue;
+    }
+
+    LazyBinaryTreeNode *next_node = current_node->right;
+    free(current_node);
+    freed_nodes++;
+    current_node = next_node;
+  }
+
+  tree->head = NULL;
+
+  return freed_nodes;
+}
+
+/**
+ * @brief counts the live nodes of a lazy binary tree
+ *
+ * @param tree Target tree
+ *
+ * @returns amount of live nodes
+ */
+int count_lazy_binary_tree_live_nodes(const LazyBinaryTree *tree)
+{
+  if (tree == NULL || tree->head == NULL)
+  {
+    return 0;
+  }
+
+  return tree->head->nodes - tree->head->dead_nodes;
+}
+
+/**
+ * @brief counts the dead nodes of a lazy binary tree
+ *
+ * @param tree Target tree
+ *
+ * @returns amount of nodes that are still linked but deleted
+ */
+int count_lazy_binary_tree_dead_nodes(const LazyBinaryTree *tree)
+{
+  if (tree == NULL || tree->head == NULL)
+  {
+    return 0;
+  }
+
+  return tree->head->dead_nodes;
+}
+
+/**
+ * @brief computes the fraction of dead nodes of a lazy binary tree
+ *
+ * @param tree Target tree
+ *
+ * @returns fraction between 0 and 1
+ *
+ * Special cases:
+ *
+ * 1. If given tree is a null pointer or it's empty, then this function will return 0
+ */
+double lazy_binary_tree_dead_ratio(const LazyBinaryTree *tree)
+{
+  if (tree == NULL || tree->head == NULL)
+  {
+    return 0;
+  }
+
+  return (double)tree->head->dead_nodes / tree->head->nodes;
+}
+
+/**
+ * @brief frees every dead node of a lazy binary tree and relinks the live ones balanced
+ *
+ * @param tree Target tree
+ *
+ * @returns amount of freed nodes or -1 if the traversal buffers can't be allocated
+ *
+ * This costs O(n), so it's meant to run out of the critical path, for example to balance a
+ * tree that was built from sorted values or to remove the tombstones that deletes left below
+ * the threshold
+ *
+ * Special cases:
+ *
+ * 1. If given tree is a null pointer or it's empty, then this function will return 0
+ *
+ * 2. If the buffers can't be allocated, the tree is left untouched and still correct
+ */
+int compact_lazy_binary_tree(LazyBinaryTree *tree)
+{
+  /**
+   * Security measure: if given tree is a null pointer, then we must return 0
+   */
+  if (tree == NULL || tree->head == NULL)
+  {
+    return 0;
+  }
+
+  return rebuild_lazy_binary_subtree(&tree->head);
+}
+
+/**
+ * @brief copies the live values of a lazy binary tree into an array in sorted order
+ *
+ * @param tree Target tree
+ * @param array Target array
+ * @param size capacity of the array
+ *
+ * @returns amount of copied values or -1 if the traversal stack can't be allocated
+ *
+ * Special cases:
+ *
+ * 1. If given tree or array are null pointers, then this function will return 0
+ *
+ * 2. If the array is smaller than the tree, only the first size values are copied
+ */
+int lazy_binary_tree_to_sorted_array(LazyBinaryTree *tree, int *array, int size)
+{
+  /**
+   * Security measure: if given tree or array are null pointers, then we must return 0
+   */
+  if (tree == NULL || array == NULL || tree->head == NULL)
+  {
+    return 0;
+  }
+
+  LazyBinaryTreeNode **stack = (LazyBinaryTreeNode **)malloc(sizeof(LazyBinaryTreeNode *) * tree->head->nodes);
+
+  /**
+   * Security measure: if stack can't be allocated, then we must return -1
+   */
+  if (stack == NULL)
+  {
+    return -1;
+  }
+
+  int stack_size = 0;
+  int copied_values = 0;
+  LazyBinaryTreeNode *current_node = tree->head;
+
+  while ((current_node != NULL || stack_size > 0) && copied_values < size)
+  {
+    while (current_node != NULL)
+    {
+      stack[stack_size++] = current_node;
+      current_node = current_node->left;
+    }
+
+    current_node = stack[--stack_size];
+
+    /**
+     * Dead nodes are skipped, but their sides are still walked
+     */
+    if (!current_node->deleted)
+    {
+      array[copied_values++] = current_node->data;
+    }
+
+    current_node = current_node->right;
+  }
+
+  free(stack);
+
+  return copied_values;
+}
@@ -436,4 +436,616 @@ void print_linked_list(LinkedListNode *head) {
    * 2) Prints null at the end of the printf because last pointer is a null pointer
    */
   printf("NULL\n");
-}
\ No newline at end of file
+}
+
+/**
+ * @brief builds a linked list with the values of an array in the same order
+ *
+ * @param array values of the new nodes
+ * @param size amount of values
+ *
+ * @returns head of the new list
+ *
+ * Nodes are linked through a tail pointer, so building costs O(n) instead of the O(n^2) of
+ * calling push_linked_list for every value
+ *
+ * Special cases:
+ *
+ * 1. If given array is a null pointer or size isn't positive, then this function will return a null pointer
+ *
+ * 2. If a node can't be allocated, the nodes built so far are freed and this function will return a null pointer
+ */
+LinkedListNode *build_linked_list_from_array(const int *array, int size)
+{
+  /**
+   * Security measure: if given array is a null pointer, then we must return null
+   */
+  if (array == NULL || size <= 0)
+  {
+    return NULL;
+  }
+
+  LinkedListNode *head = NULL;
+  LinkedListNode **tail = &head;
+
+  for (int i = 0; i < size; i++)
+  {
+    LinkedListNode *new_node = create_linked_list_node();
+
+    /**
+     * Security measure: if a node can't be allocated, then we must free the partial list
+     */
+    if (new_node == NULL)
+    {
+      free_linked_list(&head);
+      return NULL;
+    }
+
+    new_node->data = array[i];
+    *tail = new_node;
+    tail = &new_node->next;
+  }
+
+  return head;
+}
+
+/**
+ * Which values of the two lists are kept by apply_linked_list_set_operation
+ */
+typedef enum LinkedListSetOperation
+{
+  LIST_UNION,
+  LIST_INTERSECTION,
+  LIST_DIFFERENCE
+} LinkedListSetOperation;
+
+/**
+ * @brief applies a set operation over two sorted linked lists
+ *
+ * @param first Head Node of the first sorted list
+ * @param second Head Node of the second sorted list
+ * @param operation Set operation to apply
+ *
+ * @returns Head Node of a new sorted linked list
+ *
+ * Both lists are walked only once, and new nodes are linked through a tail pointer, so this
+ * function runs in O(n + m). Repeated values appear only once in the result
+ *
+ * Special cases:
+ *
+ * 1. If a node can't be allocated, then the partial result is freed and this function will
+ * return NULL
+ */
+static LinkedListNode *apply_linked_list_set_operation(LinkedListNode *first, LinkedListNode *second,
+                                                       LinkedListSetOperation operation)
+{
+  LinkedListNode *result = NULL;
+  LinkedListNode **tail = &result;
+
+  while (first != NULL || second != NULL)
+  {
+    /**
+     * 1) Takes the smallest value of both heads and checks where it comes from
+     */
+    int value;
+
+    if (second == NULL || (first != NULL && first->data <= second->data))
+    {
+      value = first->data;
+    }
+    else
+    {
+      value = second->data;
+    }
+
+    int in_first = first != NULL && first->data == value;
+    int in_second = second != NULL && second->data == value;
+
+    /**
+     * 2) Skips every copy of the value on both lists
+     */
+    while (first != NULL && first->data == value)
+    {
+      first = first->next;
+    }
+
+    while (second != NULL && second->data == value)
+    {
+      second = second->next;
+    }
+
+    if (!((operation == LIST_UNION) ||
+          (operation == LIST_INTERSECTION && in_first && in_second) ||
+          (operation == LIST_DIFFERENCE && in_first && !in_second)))
+    {
+      continue;
+    }
+
+    /**
+     * 3) Links a new node at the end of the result
+     */
+    LinkedListNode *new_node = create_linked_list_node();
+
+    /**
+     * Security measure: if new node is a null pointer we must free the partial result
+     */
+    if (new_node == NULL)
+    {
+      free_linked_list(&result);
+      return NULL;
+    }
+
+    new_node->data = value;
+    *tail = new_node;
+    tail = &new_node->next;
+  }
+
+  return result;
+}
+
+/**
+ * @brief creates a sorted linked list with the values that are in any of the given lists
+ *
+ * @param first Head Node of the first sorted list
+ * @param second Head Node of the second sorted list
+ *
+ * @returns Head Node of the new list
+ *
+ * Special cases:
+ *
+ * 1. If both lists are empty or memory can't be allocated, then this function will return NULL
+ */
+LinkedListNode *union_linked_list(LinkedListNode *first, LinkedListNode *second)
+{
+  return apply_linked_list_set_operation(first, second, LIST_UNION);
+}
+
+/**
+ * @brief creates a sorted linked list with the values that are in both given lists
+ *
+ * @param first Head Node of the first sorted list
+ * @param second Head Node of the second sorted list
+ *
+ * @returns Head Node of the new list
+ *
+ * Special cases:
+ *
+ * 1. If there are no common values or memory can't be allocated, then this function will
+ * return NULL
+ */
+LinkedListNode *intersection_linked_list(LinkedListNode *first, LinkedListNode *second)
+{
+  return apply_linked_list_set_operation(first, second, LIST_INTERSECTION);
+}
+
+/**
+ * @brief creates a sorted linked list with the values of the first list that aren't in the second one
+ *
+ * @param first Head Node of the first sorted list
+ * @param second Head Node of the second sorted list
+ *
+ * @returns Head Node of the new list
+ *
+ * Special cases:
+ *
+ * 1. If the result is empty or memory can't be allocated, then this function will return NULL
+ */
+LinkedListNode *difference_linked_list(LinkedListNode *first, LinkedListNode *second)
+{
+  return apply_linked_list_set_operation(first, second, LIST_DIFFERENCE);
+}
+
+/**
+ * @brief reverses a linked list in place
+ *
+ * @param head Head Node
+ *
+ * @returns amount of affected nodes during the operation
+ *
+ * This function only changes the next pointers, no node is allocated or freed
+ *
+ * Special cases:
+ *
+ * 1. if head variable or Head Node is a null pointer, then this function will return 0
+ */
+int reverse_linked_list(LinkedListNode **head)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (head == NULL)
+  {
+    return 0;
+  }
+
+  int reversed_nodes = 0;
+  LinkedListNode *previous_node = NULL;
+  LinkedListNode *current_node = *head;
+
+  /**
+   * 1) Makes every node point to the one that was before it
+   */
+  while (current_node != NULL)
+  {
+    LinkedListNode *next_node = current_node->next;
+    current_node->next = previous_node;
+    previous_node = current_node;
+    current_node = next_node;
+    reversed_nodes++;
+  }
+
+  *head = previous_node;
+
+  return reversed_nodes;
+}
+
+/**
+ * @brief splits a linked list in two
+ *
+ * @param head Head Node
+ * @param index amount of nodes that will stay in the given list
+ *
+ * @returns Head Node of the second part of the list
+ *
+ * After this function the given list keeps its first index nodes and the remaining
+ * nodes are returned as a new list
+ *
+ * Special cases:
+ *
+ * 1. if head variable is a null pointer, then this function will return NULL
+ *
+ * 2. if index is 0 or less, then the whole list is returned and the variable will point to NULL
+ *
+ * 3. if index is equal or greater than the list's length, then this function will return NULL
+ */
+LinkedListNode *split_linked_list(LinkedListNode **head, int index)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return NULL
+   */
+  if (head == NULL)
+  {
+    return NULL;
+  }
+
+  if (index <= 0)
+  {
+    LinkedListNode *second_part = *head;
+    *head = NULL;
+    return second_part;
+  }
+
+  /**
+   * 1) Moves to the last node that stays in the given list
+   */
+  LinkedListNode *current_node = *head;
+
+  for (int i = 1; i < index && current_node != NULL; i++)
+  {
+    current_node = current_node->next;
+  }
+
+  if (current_node == NULL)
+  {
+    return NULL;
+  }
+
+  /**
+   * 2) Cuts the list after that node
+   */
+  LinkedListNode *second_part = current_node->next;
+  current_node->next = NULL;
+
+  return second_part;
+}
+
+/**
+ * @brief links a linked list at the end of another one
+ *
+ * @param head Head Node of the first list
+ * @param last_node Last node of the first list, or NULL if it isn't known
+ * @param other Head Node of the list that goes at the end
+ *
+ * @returns amount of linked lists during the operation
+ *
+ * If the last node is given this function runs in O(1), otherwise it must walk the first list
+ *
+ * Special cases:
+ *
+ * 1. if head variable is a null pointer, then this function will return 0
+ *
+ * 2. if Head Node is a null pointer, then the variable will point to the other list
+ */
+int concat_linked_list(LinkedListNode **head, LinkedListNode *last_node, LinkedListNode *other)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (head == NULL)
+  {
+    return 0;
+  }
+
+  if (*head == NULL)
+  {
+    *head = other;
+    return 1;
+  }
+
+  /**
+   * 1) Looks for the last node only when it wasn't given
+   */
+  if (last_node == NULL)
+  {
+    last_node = take_last_from_linked_list(*head);
+  }
+
+  last_node->next = other;
+
+  return 1;
+}
+
+/**
+ * @brief merges two sorted linked lists into one
+ *
+ * @param first Head Node of the first sorted list
+ * @param second Head Node of the second sorted list
+ * @param last_node Variable where the last node of the result is stored, it can be null
+ *
+ * @returns Head Node of the merged list
+ *
+ * Nodes are relinked, nothing is allocated. When two values are equal the node from the
+ * first list goes before, so the merge is stable
+ */
+static LinkedListNode *merge_two_sorted_linked_lists(LinkedListNode *first, LinkedListNode *second,
+                                                     LinkedListNode **last_node)
+{
+  LinkedListNode *result = NULL;
+  LinkedListNode *current_node = NULL;
+  LinkedListNode **tail = &result;
+
+  while (first != NULL && second != NULL)
+  {
+    if (second->data < first->data)
+    {
+      current_node = second;
+      second = second->next;
+    }
+    else
+    {
+      current_node = first;
+      first = first->next;
+    }
+
+    *tail = current_node;
+    tail = &current_node->next;
+  }
+
+  /**
+   * 1) Links what is left from the list that didn't end
+   */
+  *tail = (first != NULL) ? first : second;
+
+  if (last_node != NULL)
+  {
+    while (*tail != NULL)
+    {
+      current_node = *tail;
+      tail = &current_node->next;
+    }
+
+    *last_node = current_node;
+  }
+
+  return result;
+}
+
+/**
+ * @brief cuts the ascending run that begins at the given node
+ *
+ * @param head First node of the run
+ *
+ * @returns first node after the run
+ *
+ * The run is detached from the rest of the list
+ */
+static LinkedListNode *cut_linked_list_run(LinkedListNode *head)
+{
+  while (head->next != NULL && head->next->data >= head->data)
+  {
+    head = head->next;
+  }
+
+  LinkedListNode *rest = head->next;
+  head->next = NULL;
+
+  return rest;
+}
+
+/**
+ * @brief sorts a linked list in ascending order
+ *
+ * @param head Head Node
+ *
+ * @returns amount of merged runs during the operation
+ *
+ * This function uses a bottom-up natural merge sort: every pass takes the ascending runs
+ * that already exist in the list and merges them by pairs, until only one run is left. The
+ * nodes are relinked, nothing is allocated, and an already sorted list is done in one pass
+ *
+ * Special cases:
+ *
+ * 1. if head variable is a null pointer, then this function will return 0
+ */
+int sort_linked_list(LinkedListNode **head)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (head == NULL)
+  {
+    return 0;
+  }
+
+  int merged_runs = 0;
+  int runs_in_pass;
+
+  do
+  {
+    runs_in_pass = 0;
+    LinkedListNode *pending = *head;
+    LinkedListNode *result = NULL;
+    LinkedListNode *last_node = NULL;
+
+    /**
+     * 1) Takes two runs, merges them and links the merged run at the end of the result
+     */
+    while (pending != NULL)
+    {
+      LinkedListNode *first = pending;
+      LinkedListNode *second = cut_linked_list_run(first);
+      pending = NULL;
+
+      if (second != NULL)
+      {
+        pending = cut_linked_list_run(second);
+        merged_runs++;
+      }
+
+      LinkedListNode *merged_last = NULL;
+      LinkedListNode *merged = merge_two_sorted_linked_lists(first, second, &merged_last);
+
+      concat_linked_list(&result, last_node, merged);
+      last_node = merged_last;
+      runs_in_pass++;
+    }
+
+    *head = result;
+
+    /**
+     * 2) When a pass finds a single run the list is sorted
+     */
+  } while (runs_in_pass > 1);
+
+  return merged_runs;
+}
+
+/**
+ * @brief restores the heap property from the given position downwards
+ *
+ * @param heap Array of Head Nodes ordered as a binary min-heap by their data
+ * @param size Amount of lists in the heap
+ * @param index Position to fix
+ */
+static void sift_down_linked_list_heap(LinkedListNode **heap, int size, int index)
+{
+  while (1)
+  {
+    int smallest = index;
+    int left = 2 * index + 1;
+    int right = left + 1;
+
+    if (left < size && heap[left]->data < heap[smallest]->data)
+    {
+      smallest = left;
+    }
+
+    if (right < size && heap[right]->data < heap[smallest]->data)
+    {
+      smallest = right;
+    }
+
+    if (smallest == index)
+    {
+      return;
+    }
+
+    LinkedListNode *temp = heap[index];
+    heap[index] = heap[smallest];
+    heap[smallest] = temp;
+    index = smallest;
+  }
+}
+
+/**
+ * @brief merges several sorted linked lists into one
+ *
+ * @param lists Array with the Head Nodes of the sorted lists
+ * @param count Amount of lists in the array
+ *
+ * @returns Head Node of the merged list
+ *
+ * This function keeps the current head of every list in a binary min-heap, so every node
+ * is placed in O(log k). Nodes are relinked and every entry of the given array will point
+ * to NULL after the operation
+ *
+ * Special cases:
+ *
+ * 1. if the heap can't be allocated, then this function will return NULL and the given lists
+ * aren't modified
+ */
+LinkedListNode *merge_sorted_linked_lists(LinkedListNode **lists, int count)
+{
+  if (lists == NULL || count <= 0)
+  {
+    return NULL;
+  }
+
+  LinkedListNode **heap = (LinkedListNode **)malloc(sizeof(LinkedListNode *) * count);
+
+  /**
+   * Security measure: if heap can't be allocated, we must return NULL
+   */
+  if (heap == NULL)
+  {
+    return NULL;
+  }
+
+  /**
+   * 1) Fills the heap with the lists that aren't empty
+   */
+  int heap_size = 0;
+
+  for (int i = 0; i < count; i++)
+  {
+    if (lists[i] != NULL)
+    {
+      heap[heap_size++] = lists[i];
+    }
+
+    lists[i] = NULL;
+  }
+
+  for (int i = heap_size / 2 - 1; i >= 0; i--)
+  {
+    sift_down_linked_list_heap(heap, heap_size, i);
+  }
+
+  /**
+   * 2) Takes the smallest head, links it into the result and replaces it with its next node
+   */
+  LinkedListNode *result = NULL;
+  LinkedListNode **tail = &result;
+
+  while (heap_size > 0)
+  {
+    LinkedListNode *smallest = heap[0];
+    *tail = smallest;
+    tail = &smallest->next;
+
+    if (smallest->next != NULL)
+    {
+      heap[0] = smallest->next;
+    }
+    else
+    {
+      heap[0] = heap[--heap_size];
+    }
+
+    sift_down_linked_list_heap(heap, heap_size, 0);
+  }
+
+  free(heap);
+
+  return result;
+}
@@ -0,0 +1,651 @@
+#define _DEFAULT_SOURCE
+
+#include "../../include/loader.h"
+#include "../../include/benchmark.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Size of every read when the input can't be mapped (pipes, stdin)
+#define LOADER_CHUNK_SIZE (1 << 20)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define LOADER_LITTLE_ENDIAN 1
+#else
+#define LOADER_LITTLE_ENDIAN 0
+#endif
+
+/**
+ * Whole input of a loader, either mapped or copied into the heap
+ */
+typedef struct LoaderInput
+{
+  char *buffer;
+  size_t length;
+  int mapped;
+} LoaderInput;
+
+/**
+ * @brief reads a file descriptor until its end in large chunks
+ *
+ * @param descriptor Source descriptor
+ * @param input Target input
+ *
+ * @returns 0 on success or -1 if reading or allocating fails
+ */
+static int read_loader_chunks(int descriptor, LoaderInput *input)
+{
+  size_t capacity = LOADER_CHUNK_SIZE;
+  char *buffer = (char *)malloc(capacity);
+
+  if (buffer == NULL)
+  {
+    return -1;
+  }
+
+  size_t length = 0;
+
+  while (1)
+  {
+    /**
+     * Doubling the buffer keeps the amount of copies linear in the input size
+     */
+    if (capacity - length < LOADER_CHUNK_SIZE)
+    {
+      char *new_buffer = (char *)realloc(buffer, capacity * 2);
+
+      if (new_buffer == NULL)
+      {
+        free(buffer);
+        return -1;
+      }
+
+      buffer = new_buffer;
+      capacity *= 2;
+    }
+
+    ssize_t read_bytes = read(descriptor, buffer + length, LOADER_CHUNK_SIZE);
+
+    if (read_bytes < 0)
+    {
+      free(buffer);
+      return -1;
+    }
+
+    if (read_bytes == 0)
+    {
+      break;
+    }
+
+    length += (size_t)read_bytes;
+  }
+
+  input->buffer = buffer;
+  input->length = length;
+  input->mapped = 0;
+
+  return 0;
+}
+
+/**
+ * @brief opens the input of a loader
+ *
+ * @param path Source file, a null pointer or "-" reads stdin
+ * @param input Target input
+ *
+ * @returns 0 on success or -1 if the input can't be read
+ *
+ * Regular files are mapped, so the parser reads the page cache directly without a copy
+ */
+static int open_loader_input(const char *path, LoaderInput *input)
+{
+  if (path == NULL || strcmp(path, "-") == 0)
+  {
+    return read_loader_chunks(STDIN_FILENO, input);
+  }
+
+  int descriptor = open(path, O_RDONLY);
+
+  if (descriptor < 0)
+  {
+    return -1;
+  }
+
+  struct stat status;
+
+  if (fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+  {
+    void *mapping = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    if (mapping != MAP_FAILED)
+    {
+      madvise(mapping, (size_t)status.st_size, MADV_SEQUENTIAL);
+      close(descriptor);
+
+      input->buffer = (char *)mapping;
+      input->length = (size_t)status.st_size;
+      input->mapped = 1;
+      return 0;
+    }
+  }
+
+  /**
+   * Empty files, FIFOs and files that can't be mapped are read in chunks
+   */
+  int result = read_loader_chunks(descriptor, input);
+  close(descriptor);
+
+  return result;
+}
+
+static void close_loader_input(LoaderInput *input)
+{
+  if (input->mapped)
+  {
+    munmap(input->buffer, input->length);
+  }
+  else
+  {
+    free(input->buffer);
+  }
+}
+
+#if LOADER_LITTLE_ENDIAN
+/**
+ * @brief checks whether 8 bytes are all ascii digits
+ *
+ * @param chunk 8 bytes loaded in little-endian order
+ *
+ * @returns 1 if every byte is between '0' and '9'
+ *
+ * Digits are 0x30 to 0x39: the high nibble must be 3 and adding 6 can't carry into it
+ */
+static inline int is_eight_decimal_digits(uint64_t chunk)
+{
+  return (((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+          0x3333333333333333ull);
+}
+
+/**
+ * @brief converts 8 ascii digits into their value
+ *
+ * @param chunk 8 digits loaded in little-endian order
+ *
+ * @returns value of the digits
+ *
+ * Pairs, then groups of 4, then the 8 digits are combined with 3 multiplications instead of 8
+ */
+static inline uint32_t parse_eight_decimal_digits(uint64_t chunk)
+{
+  const uint64_t mask = 0x000000FF000000FFull;
+  const uint64_t first_multiplier = 100 + (1000000ull << 32);
+  const uint64_t second_multiplier = 1 + (10000ull << 32);
+
+  chunk -= 0x3030303030303030ull;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & mask) * first_multiplier) + (((chunk >> 16) & mask) * second_multiplier)) >> 32;
+
+  return (uint32_t)chunk;
+}
+#endif
+
+/**
+ * @brief parses decimal ints from a text buffer
+ *
+ * @param buffer Source text, it doesn't need a null terminator
+ * @param length amount of bytes of the buffer
+ * @param keys Target array
+ * @param capacity size of the target array
+ *
+ * @returns amount of parsed keys
+ *
+ * Any byte that isn't a digit or a minus sign separates two keys. Runs of 8 digits are converted
+ * at once and the sign is applied without a branch, so the only branches left are the loop ends
+ *
+ * Special cases:
+ *
+ * 1. If given buffer or keys are null pointers, then this function will return 0
+ *
+ * 2. A minus sign without digits is ignored, and keys out of the int range wrap around
+ *
+ * 3. Parsing stops once capacity keys were parsed
+ */
+int parse_decimal_keys(const char *buffer, size_t length, int *keys, int capacity)
+{
+  /**
+   * Security measure: if given buffer or keys are null pointers, then we must return 0
+   */
+  if (buffer == NULL || keys == NULL)
+  {
+    return 0;
+  }
+
+  const unsigned char *current = (const unsigned char *)buffer;
+  const unsigned char *end = current + length;
+  int count = 0;
+
+  while (count < capacity)
+  {
+    /**
+     * 1) Skips separators until the next sign or digit
+     */
+    while (current < end && (unsigned)(*current - '0') > 9 && *current != '-')
+    {
+      current++;
+    }
+
+    if (current == end)
+    {
+      break;
+    }
+
+    uint32_t negative = (*current == '-');
+    current += negative;
+
+    const unsigned char *digits_start = current;
+    uint32_t value = 0;
+
+#if LOADER_LITTLE_ENDIAN
+    /**
+     * 2) Long keys (most random 32 bit ints have 9 or 10 digits) take 8 digits per step
+     */
+    uint64_t chunk;
+
+    while (end - current >= 8 && (memcpy(&chunk, current, 8), is_eight_decimal_digits(chunk)))
+    {
+      value = value * 100000000u + parse_eight_decimal_digits(chunk);
+      current += 8;
+    }
+#endif
+
+    /**
+     * 3) The remaining digits one by one
+     */
+    unsigned digit;
+
+    while (current < end && (digit = (unsigned)(*current - '0')) <= 9)
+    {
+      value = value * 10 + digit;
+      current++;
+    }
+
+    /**
+     * 4) Two's complement negation is xor with all ones plus one, and a lone minus sign
+     * doesn't advance count
+     */
+    keys[count] = (int)((value ^ (0u - negative)) + negative);
+    count += (current != digits_start);
+  }
+
+  return count;
+}
+
+/**
+ * @brief decodes raw little-endian int32 keys
+ *
+ * @param buffer Source bytes
+ * @param length amount of bytes of the buffer
+ * @param keys Target array
+ * @param capacity size of the target array
+ *
+ * @returns amount of decoded keys
+ *
+ * Special cases:
+ *
+ * 1. If given buffer or keys are null pointers, then this function will return 0
+ *
+ * 2. Trailing bytes that don't form a whole int32 are ignored
+ */
+int decode_binary_keys(const unsigned char *buffer, size_t length, int *keys, int capacity)
+{
+  /**
+   * Security measure: if given buffer or keys are null pointers, then we must return 0
+   */
+  if (buffer == NULL || keys == NULL || capacity <= 0)
+  {
+    return 0;
+  }
+
+  size_t count = length / 4;
+
+  if (count > (size_t)capacity)
+  {
+    count = (size_t)capacity;
+  }
+
+#if LOADER_LITTLE_ENDIAN
+  memcpy(keys, buffer, count * 4);
+#else
+  for (size_t i = 0; i < count; i++)
+  {
+    const unsigned char *bytes = buffer + i * 4;
+    keys[i] = (int)((uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24);
+  }
+#endif
+
+  return (int)count;
+}
+
+/**
+ * @brief sorts keys with a least significant digit radix sort
+ *
+ * @param keys Target array
+ * @param count amount of keys
+ *
+ * @returns 0 on success or -1 if the scratch buffer can't be allocated
+ *
+ * Three passes of 11 bits cover 32 bit keys, and passes where every key falls in the same
+ * bucket are skipped
+ *
+ * Special cases:
+ *
+ * 1. If given keys are a null pointer or there is less than 2 keys, then this function will return 0
+ */
+int sort_keys(int *keys, int count)
+{
+  if (keys == NULL || count < 2)
+  {
+    return 0;
+  }
+
+  uint32_t *source = (uint32_t *)keys;
+  uint32_t *scratch = (uint32_t *)malloc(sizeof(uint32_t) * count);
+
+  /**
+   * Security measure: if scratch buffer can't be allocated, then we must return -1
+   */
+  if (scratch == NULL)
+  {
+    return -1;
+  }
+
+  /**
+   * 1) Flipping the sign bit makes unsigned order match signed order
+   */
+  for (int i = 0; i < count; i++)
+  {
+    source[i] ^= 0x80000000u;
+  }
+
+  uint32_t *target = scratch;
+
+  for (int shift = 0; shift < 32; shift += 11)
+  {
+    int buckets[2048] = {0};
+
+    for (int i = 0; i < count; i++)
+    {
+      buckets[(source[i] >> shift) & 2047]++;
+    }
+
+    if (buckets[(source[0] >> shift) & 2047] == count)
+    {
+      continue;
+    }
+
+    /**
+     * 2) Prefix sums turn counts into the first position of every bucket
+     */
+    int position = 0;
+
+    for (int bucket = 0; bucket < 2048; bucket++)
+    {
+      int bucket_size = buckets[bucket];
+      buckets[bucket] = position;
+      position += bucket_size;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+      target[buckets[(source[i] >> shift) & 2047]++] = source[i];
+    }
+
+    uint32_t *swap = source;
+    source = target;
+    target = swap;
+  }
+
+  /**
+   * 3) The last pass may have left the keys in the scratch buffer
+   */
+  if (source != (uint32_t *)keys)
+  {
+    memcpy(keys, source, sizeof(uint32_t) * count);
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    keys[i] = (int)((uint32_t)keys[i] ^ 0x80000000u);
+  }
+
+  free(scratch);
+
+  return 0;
+}
+
+/**
+ * @brief reads every key of a file or stdin
+ *
+ * @param path Source file, a null pointer or "-" reads stdin
+ * @param format layout of the input
+ * @param count Target for the amount of loaded keys
+ *
+ * @returns array of loaded keys that must be freed by the caller
+ *
+ * Special cases:
+ *
+ * 1. If the input can't be read or the array can't be allocated, then this function will return a null pointer
+ *
+ * 2. An empty input returns an empty array, not a null pointer
+ */
+int *load_keys(const char *path, LoaderFormat format, int *count)
+{
+  if (count != NULL)
+  {
+    *count = 0;
+  }
+
+  LoaderInput input;
+
+  if (open_loader_input(path, &input) != 0)
+  {
+    return NULL;
+  }
+
+  /**
+   * 1) Every text key takes at least one digit and one separator
+   */
+  size_t capacity = (format == LOADER_BINARY) ? input.length / 4 : input.length / 2 + 1;
+
+  if (capacity > INT_MAX)
+  {
+    capacity = INT_MAX;
+  }
+
+  int *keys = (int *)malloc(sizeof(int) * (capacity + 1));
+
+  /**
+   * Security measure: if keys can't be allocated, then we must return null
+   */
+  if (keys == NULL)
+  {
+    close_loader_input(&input);
+    return NULL;
+  }
+
+  /**
+   * 2) Parses the whole input at once, so keys are never split between two chunks
+   */
+  int loaded_keys;
+
+  if (format == LOADER_BINARY)
+  {
+    loaded_keys = decode_binary_keys((const unsigned char *)input.buffer, input.length, keys, (int)capacity);
+  }
+  else
+  {
+    loaded_keys = parse_decimal_keys(input.buffer, input.length, keys, (int)capacity);
+  }
+
+  close_loader_input(&input);
+
+  /**
+   * 3) Gives back the unused part of the estimate
+   */
+  int *shrunk_keys = (int *)realloc(keys, sizeof(int) * (loaded_keys + 1));
+
+  if (shrunk_keys != NULL)
+  {
+    keys = shrunk_keys;
+  }
+
+  if (count != NULL)
+  {
+    *count = loaded_keys;
+  }
+
+  return keys;
+}
+
+/**
+ * @brief loads a linked list keeping the order of the input
+ *
+ * @param path Source file, a null pointer or "-" reads stdin
+ * @param format layout of the input
+ * @param count Target for the amount of loaded keys
+ *
+ * @returns head of the loaded list
+ *
+ * Special cases:
+ *
+ * 1. If the input is empty or can't be loaded, then this function will return a null pointer
+ */
+LinkedListNode *load_linked_list(const char *path, LoaderFormat format, int *count)
+{
+  int loaded_keys = 0;
+  int *keys = load_keys(path, format, &loaded_keys);
+  LinkedListNode *head = build_linked_list_from_array(keys, loaded_keys);
+
+  free(keys);
+
+  if (count != NULL)
+  {
+    *count = (head != NULL) ? loaded_keys : 0;
+  }
+
+  return head;
+}
+
+/**
+ * @brief loads a balanced binary tree
+ *
+ * @param path Source file, a null pointer or "-" reads stdin
+ * @param format layout of the input
+ * @param count Target for the amount of loaded keys
+ *
+ * @returns head of the loaded tree
+ *
+ * Sorting the keys first builds a balanced tree in O(n log n) total, while inserting unsorted
+ * keys one by one costs a root to leaf walk each and degenerates on sorted input
+ *
+ * Special cases:
+ *
+ * 1. If the input is empty or can't be loaded, then this function will return a null pointer
+ */
+BinaryTreeNode *load_binary_tree(const char *path, LoaderFormat format, int *count)
+{
+  int loaded_keys = 0;
+  int *keys = load_keys(path, format, &loaded_keys);
+  BinaryTreeNode *head = NULL;
+
+  if (keys != NULL && sort_keys(keys, loaded_keys) == 0)
+  {
+    head = build_binary_tree_from_sorted_array(keys, loaded_keys);
+  }
+
+  free(keys);
+
+  if (count != NULL)
+  {
+    *count = (head != NULL) ? loaded_keys : 0;
+  }
+
+  return head;
+}
+
+/**
+ * @brief runs the "load" mode of the command line
+ *
+ * @param argc amount of arguments, starting at "load"
+ * @param argv arguments: load <list|tree> <text|binary> [file]
+ *
+ * @returns exit status for main
+ *
+ * Parsing and building are timed separately, so the report shows which one dominates
+ */
+int run_loader_command(int argc, char **argv)
+{
+  if (argc < 3 || (strcmp(argv[1], "list") != 0 && strcmp(argv[1], "tree") != 0) ||
+      (strcmp(argv[2], "text") != 0 && strcmp(argv[2], "binary") != 0))
+  {
+    fprintf(stderr, "usage: main load <list|tree> <text|binary> [file]\n");
+    return 1;
+  }
+
+  LoaderFormat format = (strcmp(argv[2], "binary") == 0) ? LOADER_BINARY : LOADER_TEXT;
+  const char *path = (argc > 3) ? argv[3] : NULL;
+  int count = 0;
+
+  printf("Loading a %s from %s %s input\n", argv[1], argv[2], path != NULL ? path : "stdin");
+
+  double start = benchmark_now_seconds();
+  int *keys = load_keys(path, format, &count);
+  double parse_seconds = benchmark_now_seconds() - start;
+
+  if (keys == NULL)
+  {
+    fprintf(stderr, "can't read %s\n", path != NULL ? path : "stdin");
+    return 1;
+  }
+
+  benchmark_report("read and parse", count, parse_seconds);
+
+  int built_nodes = 0;
+  double build_seconds;
+
+  start = benchmark_now_seconds();
+
+  if (strcmp(argv[1], "list") == 0)
+  {
+    LinkedListNode *head = build_linked_list_from_array(keys, count);
+    build_seconds = benchmark_now_seconds() - start;
+    benchmark_report("build_linked_list_from_array", count, build_seconds);
+    built_nodes = free_linked_list(&head);
+  }
+  else
+  {
+    sort_keys(keys, count);
+    double sort_seconds = benchmark_now_seconds() - start;
+    benchmark_report("sort_keys", count, sort_seconds);
+
+    BinaryTreeNode *head = build_binary_tree_from_sorted_array(keys, count);
+    build_seconds = benchmark_now_seconds() - start;
+    benchmark_report("build_binary_tree_from_sorted_array", count, build_seconds - sort_seconds);
+    built_nodes = free_binary_tree(&head);
+  }
+
+  free(keys);
+
+  double seconds = parse_seconds + build_seconds;
+  printf("  loaded %d keys in %.3f ms (%.1f million keys/s)\n", built_nodes, seconds * 1e3,
+         seconds > 0 ? built_nodes / seconds / 1e6 : 0.0);
+
+  return built_nodes == count ? 0 : 1;
+}
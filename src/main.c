@@ -1,9 +1,42 @@
 #include <stdio.h>
+#include <string.h>
 #include "../include/linked_list.h"
 #include "../include/binary_tree.h"
+#include "../include/persistent_binary_tree.h"
+#include "../include/deque.h"
+#include "../include/heap.h"
+#include "../include/radix_tree.h"
+#include "../include/treap.h"
+#include "../include/compressed_list.h"
+#include "../include/bloom_filter.h"
+#include "../include/lazy_binary_tree.h"
+#include "../include/loader.h"
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+    benchmark_linked_list();
+    benchmark_deque();
+    benchmark_heap();
+    benchmark_radix_tree();
+    benchmark_compressed_list();
+    benchmark_bloom_filter();
+    return 0;
+  }
+
+  if (argc > 1 && strcmp(argv[1], "load") == 0) {
+    return run_loader_command(argc - 1, argv + 1);
+  }
 
-int main() {
   test_linked_list();
   test_binary_tree();
+  test_persistent_binary_tree();
+  test_deque();
+  test_heap();
+  test_radix_tree();
+  test_treap();
+  test_compressed_list();
+  test_bloom_filter();
+  test_lazy_binary_tree();
+  test_loader();
   return 0;
-}
\ No newline at end of file
+}
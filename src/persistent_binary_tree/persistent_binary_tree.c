@@ -0,0 +1,596 @@
+#include "../../include/persistent_binary_tree.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/**
+ * @brief adds a reference to a version of a persistent tree
+ *
+ * @param root Root of the version
+ *
+ * @returns the given root
+ *
+ * Every retained root must be given back with release_persistent_binary_tree
+ */
+PersistentBinaryTreeNode *retain_persistent_binary_tree(PersistentBinaryTreeNode *root)
+{
+  if (root != NULL)
+  {
+    atomic_fetch_add(&root->references, 1);
+  }
+
+  return root;
+}
+
+/**
+ * @brief removes a reference to a version of a persistent tree
+ *
+ * @param root Root of the version
+ *
+ * @returns amount of freed nodes
+ *
+ * Nodes that are still shared with other versions are kept. Nodes that aren't referenced
+ * anymore are exclusively owned by this function, so they are rotated to the right while
+ * they are freed and no stack is needed, even for degenerate trees
+ */
+int release_persistent_binary_tree(PersistentBinaryTreeNode *root)
+{
+  /**
+   * Security measure: if the root is still referenced, nothing is freed
+   */
+  if (root == NULL || atomic_fetch_sub(&root->references, 1) != 1)
+  {
+    return 0;
+  }
+
+  /**
+   * Nodes owned by this function keep a single reference, the one that the rotations move
+   */
+  atomic_store(&root->references, 1);
+
+  int freed_nodes = 0;
+  PersistentBinaryTreeNode *current_node = root;
+
+  while (current_node != NULL)
+  {
+    /**
+     * 1) If the left child was only referenced by this node, it becomes ours and it's rotated
+     * above the current node. Otherwise we just drop our reference to it
+     */
+    if (current_node->left != NULL)
+    {
+      PersistentBinaryTreeNode *left_node = current_node->left;
+
+      if (atomic_fetch_sub(&left_node->references, 1) == 1)
+      {
+        atomic_store(&left_node->references, 1);
+        current_node->left = left_node->right;
+        left_node->right = current_node;
+        current_node = left_node;
+      }
+      else
+      {
+        current_node->left = NULL;
+      }
+
+      continue;
+    }
+
+    /**
+     * 2) Without a left side the node can be freed and we continue with its right side, as
+     * long as it isn't shared
+     */
+    PersistentBinaryTreeNode *next_node = current_node->right;
+    free(current_node);
+    freed_nodes++;
+
+    if (next_node != NULL && atomic_fetch_sub(&next_node->references, 1) == 1)
+    {
+      atomic_store(&next_node->references, 1);
+      current_node = next_node;
+    }
+    else
+    {
+      current_node = NULL;
+    }
+  }
+
+  return freed_nodes;
+}
+
+/**
+ * @brief creates a node that references the given children
+ *
+ * @param data value of the node
+ * @param left left child, it will be retained
+ * @param right right child, it will be retained
+ *
+ * @returns created node or a null pointer if it can't be allocated
+ */
+static PersistentBinaryTreeNode *create_persistent_binary_tree_node(int data, PersistentBinaryTreeNode *left,
+                                                                    PersistentBinaryTreeNode *right)
+{
+  PersistentBinaryTreeNode *new_node = (PersistentBinaryTreeNode *)malloc(sizeof(PersistentBinaryTreeNode));
+
+  /**
+   * Security measure: if node can't be allocated, then we must return null
+   */
+  if (new_node == NULL)
+  {
+    return NULL;
+  }
+
+  new_node->data = data;
+  atomic_init(&new_node->references, 1);
+  new_node->left = retain_persistent_binary_tree(left);
+  new_node->right = retain_persistent_binary_tree(right);
+
+  return new_node;
+}
+
+/**
+ * @brief replaces the node stored in a child slot of a copied node
+ *
+ * @param slot Child slot of a node that belongs to the new version
+ * @param node Node that will be stored in the slot
+ *
+ * The slot held a reference to a node of the old version. That node is still referenced by
+ * the old version, so dropping our reference can never free it
+ */
+static void replace_persistent_binary_tree_slot(PersistentBinaryTreeNode **slot, PersistentBinaryTreeNode *node)
+{
+  if (*slot != NULL)
+  {
+    atomic_fetch_sub(&(*slot)->references, 1);
+  }
+
+  *slot = node;
+}
+
+/**
+ * @brief creates a new version of a persistent tree with one more node
+ *
+ * @param root Root of the current version
+ * @param data value of the new node
+ * @param version Variable where the root of the new version is stored
+ *
+ * @returns amount of created nodes, or -1 if memory can't be allocated
+ *
+ * Only the nodes from the root to the new leaf are copied, every other node is shared with
+ * the current version. The current version isn't modified and keeps its reference, the new
+ * version is returned with one reference that belongs to the caller
+ *
+ * Special cases:
+ *
+ * 1. If version variable is a null pointer, then this function will return 0
+ *
+ * 2. If memory can't be allocated, then version will point to NULL
+ */
+int insert_persistent_binary_tree_node(PersistentBinaryTreeNode *root, int data, PersistentBinaryTreeNode **version)
+{
+  /**
+   * Security measure: if version is a null pointer, then we must return 0
+   */
+  if (version == NULL)
+  {
+    return 0;
+  }
+
+  PersistentBinaryTreeNode *new_root = NULL;
+  PersistentBinaryTreeNode **slot = &new_root;
+  PersistentBinaryTreeNode *current_node = root;
+
+  /**
+   * 1) Copies every node on the way down, the same way insert_binary_tree_node walks the tree
+   */
+  while (current_node != NULL)
+  {
+    PersistentBinaryTreeNode *copy = create_persistent_binary_tree_node(current_node->data, current_node->left,
+                                                                        current_node->right);
+
+    if (copy == NULL)
+    {
+      release_persistent_binary_tree(new_root);
+      *version = NULL;
+      return -1;
+    }
+
+    replace_persistent_binary_tree_slot(slot, copy);
+
+    if (data >= current_node->data)
+    {
+      slot = &copy->right;
+      current_node = current_node->right;
+    }
+    else
+    {
+      slot = &copy->left;
+      current_node = current_node->left;
+    }
+  }
+
+  /**
+   * 2) Links the new leaf at the place where the walk ended
+   */
+  PersistentBinaryTreeNode *new_node = create_persistent_binary_tree_node(data, NULL, NULL);
+
+  if (new_node == NULL)
+  {
+    release_persistent_binary_tree(new_root);
+    *version = NULL;
+    return -1;
+  }
+
+  *slot = new_node;
+  *version = new_root;
+
+  return 1;
+}
+
+/**
+ * @brief searches a value in a version of a persistent tree
+ *
+ * @param root Root of the version
+ * @param data value to search
+ *
+ * @returns found node or NULL
+ *
+ * The version must be retained by the caller while the found node is used
+ */
+PersistentBinaryTreeNode *search_persistent_binary_tree_node(PersistentBinaryTreeNode *root, int data)
+{
+  PersistentBinaryTreeNode *current_node = root;
+
+  while (current_node != NULL)
+  {
+    if (data == current_node->data)
+    {
+      return current_node;
+    }
+
+    current_node = (data > current_node->data) ? current_node->right : current_node->left;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief creates a new version of a persistent tree without the given value
+ *
+ * @param root Root of the current version
+ * @param data value to delete
+ * @param version Variable where the root of the new version is stored
+ *
+ * @returns amount of deleted nodes, or -1 if memory can't be allocated
+ *
+ * Only the nodes from the root to the deleted node are copied and, when that node has two
+ * children, the nodes down to its inorder predecessor, which takes its place. The current
+ * version isn't modified and keeps its reference, the new version is returned with one
+ * reference that belongs to the caller
+ *
+ * Special cases:
+ *
+ * 1. If version variable is a null pointer, then this function will return 0
+ *
+ * 2. If the value isn't in the tree, then version will be the given root with a new reference
+ *
+ * 3. If memory can't be allocated, then version will point to NULL
+ */
+int delete_persistent_binary_tree_node(PersistentBinaryTreeNode *root, int data, PersistentBinaryTreeNode **version)
+{
+  /**
+   * Security measure: if version is a null pointer, then we must return 0
+   */
+  if (version == NULL)
+  {
+    return 0;
+  }
+
+  if (search_persistent_binary_tree_node(root, data) == NULL)
+  {
+    *version = retain_persistent_binary_tree(root);
+    return 0;
+  }
+
+  PersistentBinaryTreeNode *new_root = NULL;
+  PersistentBinaryTreeNode **slot = &new_root;
+  PersistentBinaryTreeNode *current_node = root;
+
+  /**
+   * 1) Copies every node on the way down to the node that must be deleted
+   */
+  while (current_node->data != data)
+  {
+    PersistentBinaryTreeNode *copy = create_persistent_binary_tree_node(current_node->data, current_node->left,
+                                                                        current_node->right);
+
+    if (copy == NULL)
+    {
+      release_persistent_binary_tree(new_root);
+      *version = NULL;
+      return -1;
+    }
+
+    replace_persistent_binary_tree_slot(slot, copy);
+
+    if (data > current_node->data)
+    {
+      slot = &copy->right;
+      current_node = current_node->right;
+    }
+    else
+    {
+      slot = &copy->left;
+      current_node = current_node->left;
+    }
+  }
+
+  /**
+   * 2) With one child or none, the child takes the place of the deleted node
+   */
+  if (current_node->left == NULL || current_node->right == NULL)
+  {
+    PersistentBinaryTreeNode *child = (current_node->left != NULL) ? current_node->left : current_node->right;
+    replace_persistent_binary_tree_slot(slot, retain_persistent_binary_tree(child));
+    *version = new_root;
+    return 1;
+  }
+
+  /**
+   * 3) With two children, the maximum node of the left side takes its place
+   */
+  PersistentBinaryTreeNode *predecessor = current_node->left;
+
+  while (predecessor->right != NULL)
+  {
+    predecessor = predecessor->right;
+  }
+
+  PersistentBinaryTreeNode *replacement = create_persistent_binary_tree_node(predecessor->data, NULL,
+                                                                             current_node->right);
+
+  if (replacement == NULL)
+  {
+    release_persistent_binary_tree(new_root);
+    *version = NULL;
+    return -1;
+  }
+
+  replace_persistent_binary_tree_slot(slot, replacement);
+
+  /**
+   * 4) Copies the right spine of the left side down to the predecessor, which is replaced
+   * by its own left child
+   */
+  slot = &replacement->left;
+  current_node = current_node->left;
+
+  while (current_node != predecessor)
+  {
+    PersistentBinaryTreeNode *copy = create_persistent_binary_tree_node(current_node->data, current_node->left,
+                                                                        current_node->right);
+
+    if (copy == NULL)
+    {
+      release_persistent_binary_tree(new_root);
+      *version = NULL;
+      return -1;
+    }
+
+    replace_persistent_binary_tree_slot(slot, copy);
+    slot = &copy->right;
+    current_node = current_node->right;
+  }
+
+  replace_persistent_binary_tree_slot(slot, retain_persistent_binary_tree(predecessor->left));
+  *version = new_root;
+
+  return 1;
+}
+
+/**
+ * @brief initializes an empty shared persistent tree
+ *
+ * @param tree Tree to initialize
+ *
+ * @returns 1 if the tree was initialized, otherwise 0
+ */
+int init_persistent_binary_tree(PersistentBinaryTree *tree)
+{
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  atomic_init(&tree->root, NULL);
+
+  for (int i = 0; i < PERSISTENT_BINARY_TREE_HAZARDS; i++)
+  {
+    atomic_init(&tree->hazards[i], NULL);
+  }
+
+  if (pthread_mutex_init(&tree->write_lock, NULL) != 0)
+  {
+    return 0;
+  }
+
+  return 1;
+}
+
+/**
+ * @brief releases the current version of a shared persistent tree and its lock
+ *
+ * @param tree Tree to destroy
+ *
+ * Snapshots that are still retained by readers stay valid until they are released
+ */
+void destroy_persistent_binary_tree(PersistentBinaryTree *tree)
+{
+  if (tree == NULL)
+  {
+    return;
+  }
+
+  release_persistent_binary_tree(atomic_exchange(&tree->root, NULL));
+  pthread_mutex_destroy(&tree->write_lock);
+}
+
+/**
+ * @brief takes a consistent view of a shared persistent tree
+ *
+ * @param tree Shared tree
+ *
+ * @returns retained root of the current version
+ *
+ * No lock is taken. The root is announced in a free hazard slot and read again: if it is
+ * still current, no writer can have released it yet, so it can be retained safely. The
+ * snapshot can then be read for as long as the caller wants without blocking writers. It
+ * must be given back with release_persistent_binary_tree
+ */
+PersistentBinaryTreeNode *snapshot_persistent_binary_tree(PersistentBinaryTree *tree)
+{
+  if (tree == NULL)
+  {
+    return NULL;
+  }
+
+  while (1)
+  {
+    PersistentBinaryTreeNode *root = atomic_load(&tree->root);
+
+    if (root == NULL)
+    {
+      return NULL;
+    }
+
+    /**
+     * 1) Announces the root in the first free slot, a slot is free while it holds NULL
+     */
+    for (int i = 0; i < PERSISTENT_BINARY_TREE_HAZARDS; i++)
+    {
+      PersistentBinaryTreeNode *free_slot = NULL;
+
+      if (!atomic_compare_exchange_strong(&tree->hazards[i], &free_slot, root))
+      {
+        continue;
+      }
+
+      /**
+       * 2) A writer that replaces the root afterwards sees the announcement and waits for it
+       * to be cleared, so the root can only be retained while it is still current
+       */
+      PersistentBinaryTreeNode *snapshot = NULL;
+
+      if (atomic_load(&tree->root) == root)
+      {
+        snapshot = retain_persistent_binary_tree(root);
+      }
+
+      atomic_store(&tree->hazards[i], NULL);
+
+      if (snapshot != NULL)
+      {
+        return snapshot;
+      }
+
+      break;
+    }
+  }
+}
+
+/**
+ * @brief replaces the current version of a shared persistent tree
+ *
+ * @param tree Shared tree, its write lock must be held
+ * @param version New version, its reference is moved into the tree
+ */
+static void publish_persistent_binary_tree(PersistentBinaryTree *tree, PersistentBinaryTreeNode *version)
+{
+  PersistentBinaryTreeNode *old_root = atomic_exchange(&tree->root, version);
+
+  if (old_root == NULL)
+  {
+    return;
+  }
+
+  /**
+   * Readers that announced the old root are only retaining it, which takes a few instructions
+   */
+  for (int i = 0; i < PERSISTENT_BINARY_TREE_HAZARDS; i++)
+  {
+    while (atomic_load(&tree->hazards[i]) == old_root)
+    {
+      sched_yield();
+    }
+  }
+
+  /**
+   * Readers that took a snapshot keep the old version alive
+   */
+  release_persistent_binary_tree(old_root);
+}
+
+/**
+ * @brief inserts a value into a shared persistent tree
+ *
+ * @param tree Shared tree
+ * @param data value of the new node
+ *
+ * @returns amount of created nodes, or -1 if memory can't be allocated
+ */
+int insert_persistent_binary_tree(PersistentBinaryTree *tree, int data)
+{
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  pthread_mutex_lock(&tree->write_lock);
+
+  PersistentBinaryTreeNode *version = NULL;
+  int created_nodes = insert_persistent_binary_tree_node(atomic_load(&tree->root), data, &version);
+
+  if (created_nodes > 0)
+  {
+    publish_persistent_binary_tree(tree, version);
+  }
+
+  pthread_mutex_unlock(&tree->write_lock);
+
+  return created_nodes;
+}
+
+/**
+ * @brief deletes a value from a shared persistent tree
+ *
+ * @param tree Shared tree
+ * @param data value to delete
+ *
+ * @returns amount of deleted nodes, or -1 if memory can't be allocated
+ */
+int delete_persistent_binary_tree(PersistentBinaryTree *tree, int data)
+{
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  pthread_mutex_lock(&tree->write_lock);
+
+  PersistentBinaryTreeNode *version = NULL;
+  int deleted_nodes = delete_persistent_binary_tree_node(atomic_load(&tree->root), data, &version);
+
+  if (deleted_nodes > 0)
+  {
+    publish_persistent_binary_tree(tree, version);
+  }
+  else
+  {
+    release_persistent_binary_tree(version);
+  }
+
+  pthread_mutex_unlock(&tree->write_lock);
+
+  return deleted_nodes;
+}
@@ -0,0 +1,1068 @@
+#include "../../include/radix_tree.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+_Static_assert(sizeof(uintptr_t) > sizeof(uint32_t), "leaves need room for a 32 bit key and a tag bit");
+
+typedef enum RadixTreeNodeType
+{
+  NODE4,
+  NODE16,
+  NODE48,
+  NODE256
+} RadixTreeNodeType;
+
+// Header shared by every inner node. prefix holds the bytes that every key below this node
+// has in common (path compression), they are consumed before choosing a child
+struct RadixTreeNode
+{
+  uint8_t type;
+  uint8_t prefix_length;
+  uint16_t count;
+  uint8_t prefix[4];
+};
+
+// Up to 4 children, keys sorted
+typedef struct RadixTreeNode4
+{
+  RadixTreeNode header;
+  uint8_t keys[4];
+  RadixTreeNode *children[4];
+} RadixTreeNode4;
+
+// Up to 16 children, keys sorted so they can be compared all at once
+typedef struct RadixTreeNode16
+{
+  RadixTreeNode header;
+  uint8_t keys[16];
+  RadixTreeNode *children[16];
+} RadixTreeNode16;
+
+// Up to 48 children, child_index maps a byte to its slot plus one (0 means no child)
+typedef struct RadixTreeNode48
+{
+  RadixTreeNode header;
+  uint8_t child_index[256];
+  RadixTreeNode *children[48];
+} RadixTreeNode48;
+
+// One slot for every byte
+typedef struct RadixTreeNode256
+{
+  RadixTreeNode header;
+  RadixTreeNode *children[256];
+} RadixTreeNode256;
+
+/**
+ * Keys are stored with the sign bit flipped, so comparing their bytes from the most
+ * significant one gives the same order as comparing the ints
+ */
+static inline uint32_t encode_radix_tree_key(int key)
+{
+  return (uint32_t)key ^ 0x80000000u;
+}
+
+static inline int decode_radix_tree_key(uint32_t key)
+{
+  return (int)(key ^ 0x80000000u);
+}
+
+static inline uint8_t radix_tree_key_byte(uint32_t key, int depth)
+{
+  return (uint8_t)(key >> (24 - 8 * depth));
+}
+
+static inline int is_radix_tree_leaf(const RadixTreeNode *node)
+{
+  return ((uintptr_t)node & 1) != 0;
+}
+
+static inline RadixTreeNode *make_radix_tree_leaf(uint32_t key)
+{
+  return (RadixTreeNode *)(((uintptr_t)key << 1) | 1);
+}
+
+static inline uint32_t radix_tree_leaf_key(const RadixTreeNode *node)
+{
+  return (uint32_t)((uintptr_t)node >> 1);
+}
+
+/**
+ * @brief allocates an empty inner node
+ *
+ * @param type type of the node
+ *
+ * @returns created node or a null pointer if it can't be allocated
+ */
+static RadixTreeNode *create_radix_tree_node(RadixTreeNodeType type)
+{
+  size_t sizes[] = {sizeof(RadixTreeNode4), sizeof(RadixTreeNode16), sizeof(RadixTreeNode48),
+                    sizeof(RadixTreeNode256)};
+
+  RadixTreeNode *new_node = (RadixTreeNode *)calloc(1, sizes[type]);
+
+  /**
+   * Security measure: if node can't be allocated, then we must return null
+   */
+  if (new_node == NULL)
+  {
+    return NULL;
+  }
+
+  new_node->type = (uint8_t)type;
+
+  return new_node;
+}
+
+/**
+ * @brief copies the prefix and the amount of children into a node of another type
+ */
+static void copy_radix_tree_header(RadixTreeNode *destination, const RadixTreeNode *source)
+{
+  destination->prefix_length = source->prefix_length;
+  destination->count = source->count;
+  memcpy(destination->prefix, source->prefix, sizeof(source->prefix));
+}
+
+/**
+ * @brief looks for the child slot that belongs to a byte
+ *
+ * @param node inner node
+ * @param byte byte of the key at the node's depth
+ *
+ * @returns pointer to the slot, or NULL if there's no child for that byte
+ */
+static RadixTreeNode **find_radix_tree_child(RadixTreeNode *node, uint8_t byte)
+{
+  switch (node->type)
+  {
+  case NODE4:
+  {
+    RadixTreeNode4 *node4 = (RadixTreeNode4 *)node;
+
+    for (int i = 0; i < node->count; i++)
+    {
+      if (node4->keys[i] == byte)
+      {
+        return &node4->children[i];
+      }
+    }
+
+    return NULL;
+  }
+  case NODE16:
+  {
+    RadixTreeNode16 *node16 = (RadixTreeNode16 *)node;
+#ifdef __SSE2__
+    /**
+     * Compares the byte with the 16 keys at once and keeps the matches of used keys
+     */
+    __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte), _mm_loadu_si128((const __m128i *)node16->keys));
+    int mask = _mm_movemask_epi8(matches) & ((1 << node->count) - 1);
+
+    return (mask != 0) ? &node16->children[__builtin_ctz(mask)] : NULL;
+#else
+    for (int i = 0; i < node->count; i++)
+    {
+      if (node16->keys[i] == byte)
+      {
+        return &node16->children[i];
+      }
+    }
+
+    return NULL;
+#endif
+  }
+  case NODE48:
+  {
+    RadixTreeNode48 *node48 = (RadixTreeNode48 *)node;
+    int index = node48->child_index[byte];
+
+    return (index != 0) ? &node48->children[index - 1] : NULL;
+  }
+  default:
+  {
+    RadixTreeNode256 *node256 = (RadixTreeNode256 *)node;
+
+    return (node256->children[byte] != NULL) ? &node256->children[byte] : NULL;
+  }
+  }
+}
+
+/**
+ * @brief adds a child to a node with sorted keys
+ *
+ * @param keys keys array of a Node4 or a Node16
+ * @param children children array of the same node
+ * @param count amount of children before the operation
+ * @param byte byte of the new child
+ * @param child new child
+ */
+static void insert_sorted_radix_tree_child(uint8_t *keys, RadixTreeNode **children, int count, uint8_t byte,
+                                           RadixTreeNode *child)
+{
+  int position = 0;
+
+  while (position < count && keys[position] < byte)
+  {
+    position++;
+  }
+
+  memmove(keys + position + 1, keys + position, count - position);
+  memmove(children + position + 1, children + position, sizeof(RadixTreeNode *) * (count - position));
+  keys[position] = byte;
+  children[position] = child;
+}
+
+/**
+ * @brief adds a child to an inner node
+ *
+ * @param reference slot that points to the node, it's updated when the node grows
+ * @param node inner node
+ * @param byte byte of the new child
+ * @param child new child
+ *
+ * @returns 1 if the child was added, or 0 if a bigger node can't be allocated
+ *
+ * Full nodes are replaced by the next type: Node4 -> Node16 -> Node48 -> Node256
+ */
+static int add_radix_tree_child(RadixTreeNode **reference, RadixTreeNode *node, uint8_t byte, RadixTreeNode *child)
+{
+  switch (node->type)
+  {
+  case NODE4:
+  {
+    RadixTreeNode4 *node4 = (RadixTreeNode4 *)node;
+
+    if (node->count < 4)
+    {
+      insert_sorted_radix_tree_child(node4->keys, node4->children, node->count, byte, child);
+      node->count++;
+      return 1;
+    }
+
+    RadixTreeNode16 *node16 = (RadixTreeNode16 *)create_radix_tree_node(NODE16);
+
+    if (node16 == NULL)
+    {
+      return 0;
+    }
+
+    copy_radix_tree_header(&node16->header, node);
+    memcpy(node16->keys, node4->keys, sizeof(node4->keys));
+    memcpy(node16->children, node4->children, sizeof(node4->children));
+    *reference = &node16->header;
+    free(node);
+
+    return add_radix_tree_child(reference, &node16->header, byte, child);
+  }
+  case NODE16:
+  {
+    RadixTreeNode16 *node16 = (RadixTreeNode16 *)node;
+
+    if (node->count < 16)
+    {
+      insert_sorted_radix_tree_child(node16->keys, node16->children, node->count, byte, child);
+      node->count++;
+      return 1;
+    }
+
+    RadixTreeNode48 *node48 = (RadixTreeNode48 *)create_radix_tree_node(NODE48);
+
+    if (node48 == NULL)
+    {
+      return 0;
+    }
+
+    copy_radix_tree_header(&node48->header, node);
+
+    for (int i = 0; i < node->count; i++)
+    {
+      node48->child_index[node16->keys[i]] = (uint8_t)(i + 1);
+      node48->children[i] = node16->children[i];
+    }
+
+    *reference = &node48->header;
+    free(node);
+
+    return add_radix_tree_child(reference, &node48->header, byte, child);
+  }
+  case NODE48:
+  {
+    RadixTreeNode48 *node48 = (RadixTreeNode48 *)node;
+
+    /**
+     * Slots are kept compact, so the first free slot is always the one after the last child
+     */
+    if (node->count < 48)
+    {
+      node48->children[node->count] = child;
+      node48->child_index[byte] = (uint8_t)(node->count + 1);
+      node->count++;
+      return 1;
+    }
+
+    RadixTreeNode256 *node256 = (RadixTreeNode256 *)create_radix_tree_node(NODE256);
+
+    if (node256 == NULL)
+    {
+      return 0;
+    }
+
+    copy_radix_tree_header(&node256->header, node);
+
+    for (int i = 0; i < 256; i++)
+    {
+      if (node48->child_index[i] != 0)
+      {
+        node256->children[i] = node48->children[node48->child_index[i] - 1];
+      }
+    }
+
+    *reference = &node256->header;
+    free(node);
+
+    return add_radix_tree_child(reference, &node256->header, byte, child);
+  }
+  default:
+  {
+    RadixTreeNode256 *node256 = (RadixTreeNode256 *)node;
+
+    node256->children[byte] = child;
+    node->count++;
+
+    return 1;
+  }
+  }
+}
+
+/**
+ * @brief removes a child from a node with sorted keys
+ *
+ * @param keys keys array of a Node4 or a Node16
+ * @param children children array of the same node
+ * @param count amount of children before the operation
+ * @param slot slot of the child that must be removed
+ */
+static void remove_sorted_radix_tree_child(uint8_t *keys, RadixTreeNode **children, int count, RadixTreeNode **slot)
+{
+  int position = (int)(slot - children);
+
+  memmove(keys + position, keys + position + 1, count - position - 1);
+  memmove(children + position, children + position + 1, sizeof(RadixTreeNode *) * (count - position - 1));
+}
+
+/**
+ * @brief removes a child from an inner node
+ *
+ * @param reference slot that points to the node, it's updated when the node shrinks
+ * @param node inner node
+ * @param byte byte of the removed child
+ * @param slot slot of the removed child
+ *
+ * Nodes that become too empty are replaced by the previous type. The limits are lower than
+ * the ones used to grow, so a key that is inserted and deleted again doesn't resize the
+ * node every time. If a smaller node can't be allocated the bigger one is kept
+ */
+static void remove_radix_tree_child(RadixTreeNode **reference, RadixTreeNode *node, uint8_t byte,
+                                    RadixTreeNode **slot)
+{
+  switch (node->type)
+  {
+  case NODE4:
+  {
+    RadixTreeNode4 *node4 = (RadixTreeNode4 *)node;
+
+    remove_sorted_radix_tree_child(node4->keys, node4->children, node->count, slot);
+    node->count--;
+
+    if (node->count != 1)
+    {
+      return;
+    }
+
+    /**
+     * A Node4 with a single child isn't needed: the child takes its place and, if it's an
+     * inner node, its prefix grows with the node's prefix and the byte that led to it
+     */
+    RadixTreeNode *child = node4->children[0];
+
+    if (!is_radix_tree_leaf(child))
+    {
+      uint8_t prefix[4];
+      int length = node->prefix_length;
+
+      memcpy(prefix, node->prefix, length);
+      prefix[length++] = node4->keys[0];
+      memcpy(prefix + length, child->prefix, child->prefix_length);
+      length += child->prefix_length;
+
+      memcpy(child->prefix, prefix, length);
+      child->prefix_length = (uint8_t)length;
+    }
+
+    *reference = child;
+    free(node);
+
+    return;
+  }
+  case NODE16:
+  {
+    RadixTreeNode16 *node16 = (RadixTreeNode16 *)node;
+
+    remove_sorted_radix_tree_child(node16->keys, node16->children, node->count, slot);
+    node->count--;
+
+    if (node->count > 3)
+    {
+      return;
+    }
+
+    RadixTreeNode4 *node4 = (RadixTreeNode4 *)create_radix_tree_node(NODE4);
+
+    if (node4 == NULL)
+    {
+      return;
+    }
+
+    copy_radix_tree_header(&node4->header, node);
+    memcpy(node4->keys, node16->keys, node->count);
+    memcpy(node4->children, node16->children, sizeof(RadixTreeNode *) * node->count);
+    *reference = &node4->header;
+    free(node);
+
+    return;
+  }
+  case NODE48:
+  {
+    RadixTreeNode48 *node48 = (RadixTreeNode48 *)node;
+    int position = node48->child_index[byte] - 1;
+    int last = node->count - 1;
+
+    /**
+     * 1) Keeps the slots compact by moving the last child into the freed slot
+     */
+    node48->child_index[byte] = 0;
+
+    if (position != last)
+    {
+      node48->children[position] = node48->children[last];
+
+      for (int i = 0; i < 256; i++)
+      {
+        if (node48->child_index[i] == last + 1)
+        {
+          node48->child_index[i] = (uint8_t)(position + 1);
+          break;
+        }
+      }
+    }
+
+    node48->children[last] = NULL;
+    node->count--;
+
+    if (node->count > 12)
+    {
+      return;
+    }
+
+    RadixTreeNode16 *node16 = (RadixTreeNode16 *)create_radix_tree_node(NODE16);
+
+    if (node16 == NULL)
+    {
+      return;
+    }
+
+    /**
+     * 2) Walking the bytes in order gives the sorted keys of the Node16
+     */
+    copy_radix_tree_header(&node16->header, node);
+
+    int added = 0;
+    for (int i = 0; i < 256; i++)
+    {
+      if (node48->child_index[i] != 0)
+      {
+        node16->keys[added] = (uint8_t)i;
+        node16->children[added] = node48->children[node48->child_index[i] - 1];
+        added++;
+      }
+    }
+
+    *reference = &node16->header;
+    free(node);
+
+    return;
+  }
+  default:
+  {
+    RadixTreeNode256 *node256 = (RadixTreeNode256 *)node;
+
+    node256->children[byte] = NULL;
+    node->count--;
+
+    if (node->count > 37)
+    {
+      return;
+    }
+
+    RadixTreeNode48 *node48 = (RadixTreeNode48 *)create_radix_tree_node(NODE48);
+
+    if (node48 == NULL)
+    {
+      return;
+    }
+
+    copy_radix_tree_header(&node48->header, node);
+
+    int added = 0;
+    for (int i = 0; i < 256; i++)
+    {
+      if (node256->children[i] != NULL)
+      {
+        node48->children[added] = node256->children[i];
+        node48->child_index[i] = (uint8_t)(added + 1);
+        added++;
+      }
+    }
+
+    *reference = &node48->header;
+    free(node);
+
+    return;
+  }
+  }
+}
+
+/**
+ * @brief counts how many bytes of a node's prefix match the key
+ *
+ * @param node inner node
+ * @param key encoded key
+ * @param depth depth of the node
+ *
+ * @returns amount of matching bytes
+ */
+static int match_radix_tree_prefix(const RadixTreeNode *node, uint32_t key, int depth)
+{
+  int matched = 0;
+
+  while (matched < node->prefix_length && node->prefix[matched] == radix_tree_key_byte(key, depth + matched))
+  {
+    matched++;
+  }
+
+  return matched;
+}
+
+/**
+ * @brief init an adaptive radix tree
+ *
+ * @returns created tree
+ *
+ * Special cases:
+ *
+ * 1. If the tree can't be allocated in memory, then this function will return a null pointer
+ */
+RadixTree *create_radix_tree()
+{
+  RadixTree *new_tree = (RadixTree *)malloc(sizeof(RadixTree));
+
+  /**
+   * Security measure: if tree can't be allocated, then we must return null
+   */
+  if (new_tree == NULL)
+  {
+    return NULL;
+  }
+
+  new_tree->root = NULL;
+  new_tree->size = 0;
+
+  return new_tree;
+}
+
+/**
+ * @brief frees an inner node and everything below it
+ *
+ * Recursion is bounded by the 4 bytes of the key
+ */
+static void free_radix_tree_node(RadixTreeNode *node)
+{
+  if (node == NULL || is_radix_tree_leaf(node))
+  {
+    return;
+  }
+
+  switch (node->type)
+  {
+  case NODE4:
+    for (int i = 0; i < node->count; i++)
+    {
+      free_radix_tree_node(((RadixTreeNode4 *)node)->children[i]);
+    }
+    break;
+  case NODE16:
+    for (int i = 0; i < node->count; i++)
+    {
+      free_radix_tree_node(((RadixTreeNode16 *)node)->children[i]);
+    }
+    break;
+  case NODE48:
+    for (int i = 0; i < node->count; i++)
+    {
+      free_radix_tree_node(((RadixTreeNode48 *)node)->children[i]);
+    }
+    break;
+  default:
+    for (int i = 0; i < 256; i++)
+    {
+      free_radix_tree_node(((RadixTreeNode256 *)node)->children[i]);
+    }
+    break;
+  }
+
+  free(node);
+}
+
+/**
+ * @brief frees an adaptive radix tree
+ *
+ * @param tree pointer to the tree variable
+ *
+ * @returns amount of keys that the tree had
+ */
+int free_radix_tree(RadixTree **tree)
+{
+  /**
+   * Security measure: if variable is a null pointer, we must return 0
+   */
+  if (tree == NULL || *tree == NULL)
+  {
+    return 0;
+  }
+
+  int freed_keys = (*tree)->size;
+
+  free_radix_tree_node((*tree)->root);
+  free(*tree);
+  *tree = NULL;
+
+  return freed_keys;
+}
+
+/**
+ * @brief adds a key to an adaptive radix tree
+ *
+ * @param tree Target tree
+ * @param key key to add
+ *
+ * @returns amount of added keys, or -1 if memory can't be allocated
+ *
+ * Special cases:
+ *
+ * 1. If the key is already in the tree, then this function will return 0
+ */
+int insert_radix_tree(RadixTree *tree, int key)
+{
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  uint32_t encoded_key = encode_radix_tree_key(key);
+  RadixTreeNode *leaf = make_radix_tree_leaf(encoded_key);
+  RadixTreeNode **reference = &tree->root;
+  int depth = 0;
+
+  while (1)
+  {
+    RadixTreeNode *node = *reference;
+
+    /**
+     * 1) An empty slot just takes the leaf
+     */
+    if (node == NULL)
+    {
+      *reference = leaf;
+      tree->size++;
+      return 1;
+    }
+
+    /**
+     * 2) A leaf with another key is replaced by a Node4 that holds both leaves. Its prefix
+     * is made of the bytes that both keys share
+     */
+    if (is_radix_tree_leaf(node))
+    {
+      uint32_t existing_key = radix_tree_leaf_key(node);
+
+      if (existing_key == encoded_key)
+      {
+        return 0;
+      }
+
+      RadixTreeNode *new_node = create_radix_tree_node(NODE4);
+
+      if (new_node == NULL)
+      {
+        return -1;
+      }
+
+      int length = 0;
+
+      while (radix_tree_key_byte(existing_key, depth + length) == radix_tree_key_byte(encoded_key, depth + length))
+      {
+        new_node->prefix[length] = radix_tree_key_byte(encoded_key, depth + length);
+        length++;
+      }
+
+      new_node->prefix_length = (uint8_t)length;
+      add_radix_tree_child(&new_node, new_node, radix_tree_key_byte(existing_key, depth + length), node);
+      add_radix_tree_child(&new_node, new_node, radix_tree_key_byte(encoded_key, depth + length), leaf);
+      *reference = new_node;
+      tree->size++;
+
+      return 1;
+    }
+
+    /**
+     * 3) If the key leaves the node's prefix, a Node4 is placed above the node with the
+     * part of the prefix that matched
+     */
+    int matched = match_radix_tree_prefix(node, encoded_key, depth);
+
+    if (matched < node->prefix_length)
+    {
+      RadixTreeNode *new_node = create_radix_tree_node(NODE4);
+
+      if (new_node == NULL)
+      {
+        return -1;
+      }
+
+      new_node->prefix_length = (uint8_t)matched;
+      memcpy(new_node->prefix, node->prefix, matched);
+
+      uint8_t node_byte = node->prefix[matched];
+      node->prefix_length -= (uint8_t)(matched + 1);
+      memmove(node->prefix, node->prefix + matched + 1, node->prefix_length);
+
+      add_radix_tree_child(&new_node, new_node, node_byte, node);
+      add_radix_tree_child(&new_node, new_node, radix_tree_key_byte(encoded_key, depth + matched), leaf);
+      *reference = new_node;
+      tree->size++;
+
+      return 1;
+    }
+
+    /**
+     * 4) Otherwise we go down to the child of the next byte, or add the leaf as a new child
+     */
+    depth += node->prefix_length;
+    uint8_t byte = radix_tree_key_byte(encoded_key, depth);
+    RadixTreeNode **child = find_radix_tree_child(node, byte);
+
+    if (child == NULL)
+    {
+      if (!add_radix_tree_child(reference, node, byte, leaf))
+      {
+        return -1;
+      }
+
+      tree->size++;
+      return 1;
+    }
+
+    reference = child;
+    depth++;
+  }
+}
+
+/**
+ * @brief checks if a key is in an adaptive radix tree
+ *
+ * @param tree Target tree
+ * @param key key to search
+ *
+ * @returns 1 if the key was found, otherwise 0
+ *
+ * Every visited node consumes at least one byte of the key, so at most 4 nodes are visited
+ */
+int search_radix_tree(RadixTree *tree, int key)
+{
+  if (tree == NULL)
+  {
+    return 0;
+  }
+
+  uint32_t encoded_key = encode_radix_tree_key(key);
+  RadixTreeNode *node = tree->root;
+  int depth = 0;
+
+  while (node != NULL)
+  {
+    /**
+     * 1) Leaves may hang above the last byte, so the whole key is compared
+     */
+    if (is_radix_tree_leaf(node))
+    {
+      return radix_tree_leaf_key(node) == encoded_key;
+    }
+
+    if (match_radix_tree_prefix(node, encoded_key, depth) != node->prefix_length)
+    {
+      return 0;
+    }
+
+    /**
+     * 2) Goes down to the child of the next byte
+     */
+    depth += node->prefix_length;
+    RadixTreeNode **child = find_radix_tree_child(node, radix_tree_key_byte(encoded_key, depth));
+
+    if (child == NULL)
+    {
+      return 0;
+    }
+
+    node = *child;
+    depth++;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief removes a key from an adaptive radix tree
+ *
+ * @param tree Target tree
+ * @param key key to remove
+ *
+ * @returns amount of removed keys during the operation
+ */
+int delete_radix_tree(RadixTree *tree, int key)
+{
+  if (tree == NULL || tree->root == NULL)
+  {
+    return 0;
+  }
+
+  uint32_t encoded_key = encode_radix_tree_key(key);
+
+  /**
+   * Security measure: a tree with a single key has a leaf as root
+   */
+  if (is_radix_tree_leaf(tree->root))
+  {
+    if (radix_tree_leaf_key(tree->root) != encoded_key)
+    {
+      return 0;
+    }
+
+    tree->root = NULL;
+    tree->size--;
+    return 1;
+  }
+
+  RadixTreeNode **reference = &tree->root;
+  int depth = 0;
+
+  while (1)
+  {
+    RadixTreeNode *node = *reference;
+
+    if (match_radix_tree_prefix(node, encoded_key, depth) != node->prefix_length)
+    {
+      return 0;
+    }
+
+    depth += node->prefix_length;
+    uint8_t byte = radix_tree_key_byte(encoded_key, depth);
+    RadixTreeNode **child = find_radix_tree_child(node, byte);
+
+    if (child == NULL)
+    {
+      return 0;
+    }
+
+    /**
+     * 1) The leaf is removed from its parent, which may shrink or be replaced by its only
+     * remaining child
+     */
+    if (is_radix_tree_leaf(*child))
+    {
+      if (radix_tree_leaf_key(*child) != encoded_key)
+      {
+        return 0;
+      }
+
+      remove_radix_tree_child(reference, node, byte, child);
+      tree->size--;
+      return 1;
+    }
+
+    reference = child;
+    depth++;
+  }
+}
+
+/**
+ * @brief takes the next child of a node in byte order
+ *
+ * @param node inner node
+ * @param position position where the search starts, it's moved after the returned child
+ *
+ * @returns next child, or NULL if there are no more children
+ */
+static RadixTreeNode *next_radix_tree_child(RadixTreeNode *node, int *position)
+{
+  switch (node->type)
+  {
+  case NODE4:
+    return (*position < node->count) ? ((RadixTreeNode4 *)node)->children[(*position)++] : NULL;
+  case NODE16:
+    return (*position < node->count) ? ((RadixTreeNode16 *)node)->children[(*position)++] : NULL;
+  case NODE48:
+  {
+    RadixTreeNode48 *node48 = (RadixTreeNode48 *)node;
+
+    while (*position < 256)
+    {
+      int index = node48->child_index[(*position)++];
+
+      if (index != 0)
+      {
+        return node48->children[index - 1];
+      }
+    }
+
+    return NULL;
+  }
+  default:
+  {
+    RadixTreeNode256 *node256 = (RadixTreeNode256 *)node;
+
+    while (*position < 256)
+    {
+      RadixTreeNode *child = node256->children[(*position)++];
+
+      if (child != NULL)
+      {
+        return child;
+      }
+    }
+
+    return NULL;
+  }
+  }
+}
+
+/**
+ * @brief prepares an ordered iteration over an adaptive radix tree
+ *
+ * @param iterator iterator to initialize
+ * @param tree Target tree, it must not be modified while the iterator is used
+ */
+void init_radix_tree_iterator(RadixTreeIterator *iterator, RadixTree *tree)
+{
+  if (iterator == NULL)
+  {
+    return;
+  }
+
+  iterator->depth = 0;
+
+  if (tree != NULL && tree->root != NULL)
+  {
+    iterator->nodes[0] = tree->root;
+    iterator->positions[0] = 0;
+    iterator->depth = 1;
+  }
+}
+
+/**
+ * @brief takes the next key of an ordered iteration
+ *
+ * @param iterator initialized iterator
+ * @param key variable where the key is stored
+ *
+ * @returns 1 if a key was taken, or 0 when the iteration is over
+ *
+ * Children are visited in byte order, which is the order of the keys
+ */
+int next_radix_tree_iterator(RadixTreeIterator *iterator, int *key)
+{
+  if (iterator == NULL || key == NULL)
+  {
+    return 0;
+  }
+
+  while (iterator->depth > 0)
+  {
+    int top = iterator->depth - 1;
+    RadixTreeNode *node = iterator->nodes[top];
+
+    /**
+     * 1) A leaf on top of the stack is the next key
+     */
+    if (is_radix_tree_leaf(node))
+    {
+      iterator->depth--;
+      *key = decode_radix_tree_key(radix_tree_leaf_key(node));
+      return 1;
+    }
+
+    /**
+     * 2) Otherwise its next child is pushed, or the node is removed when it has no more
+     */
+    RadixTreeNode *child = next_radix_tree_child(node, &iterator->positions[top]);
+
+    if (child == NULL)
+    {
+      iterator->depth--;
+      continue;
+    }
+
+    iterator->nodes[iterator->depth] = child;
+    iterator->positions[iterator->depth] = 0;
+    iterator->depth++;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief copies the keys of an adaptive radix tree into an array, in order
+ *
+ * @param tree Target tree
+ * @param array Destination array
+ * @param size Capacity of the destination array
+ *
+ * @returns amount of copied keys
+ */
+int radix_tree_to_sorted_array(RadixTree *tree, int *array, int size)
+{
+  if (array == NULL)
+  {
+    return 0;
+  }
+
+  RadixTreeIterator iterator;
+  int copied_keys = 0;
+
+  init_radix_tree_iterator(&iterator, tree);
+
+  while (copied_keys < size && next_radix_tree_iterator(&iterator, &array[copied_keys]))
+  {
+    copied_keys++;
+  }
+
+  return copied_keys;
+}
@@ -1,5 +1,6 @@
 #include "binary_tree.h"
 
+#include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
 
@@ -55,6 +56,12 @@ void test_delete_tree_node()
 
   delete_binary_tree_node(head, 15);
 
+  // The lowest value of the right side takes the place of a node with two children
+  assert(head->data == 10);
+  assert(remove_binary_tree_node(&head, 20) == 1);
+  assert(head->right->data == 30 && head->right->left->data == 18 && head->right->right == NULL);
+  assert(remove_binary_tree_node(&head, 20) == 0);
+
   print_binary_tree_inorder_route(head);
 
   printf("\nInorder print works!\n");
@@ -67,8 +74,121 @@ void test_delete_tree_node()
    */
 }
 
+void test_set_operations_tree()
+{
+  printf("Testing set operations\n");
+  BinaryTreeNode *first = NULL;
+  BinaryTreeNode *second = NULL;
+
+  // Degenerate tree with a repeated value: 1 -> 2 -> 3 -> 3 -> 4 -> 5
+  insert_binary_tree_node(&first, 1);
+  insert_binary_tree_node(&first, 2);
+  insert_binary_tree_node(&first, 3);
+  insert_binary_tree_node(&first, 3);
+  insert_binary_tree_node(&first, 4);
+  insert_binary_tree_node(&first, 5);
+
+  insert_binary_tree_node(&second, 4);
+  insert_binary_tree_node(&second, 7);
+  insert_binary_tree_node(&second, 3);
+  insert_binary_tree_node(&second, 6);
+
+  assert(count_binary_tree_nodes(first) == 6);
+  assert(count_binary_tree_nodes(second) == 4);
+
+  int values[8];
+
+  BinaryTreeNode *union_tree = union_binary_tree(first, second);
+  assert(count_binary_tree_nodes(union_tree) == 7);
+  assert(binary_tree_to_sorted_array(union_tree, values, 7) == 7);
+  for (int i = 0; i < 7; i++)
+  {
+    assert(values[i] == i + 1);
+  }
+  // Balanced: 7 nodes must fit in 3 levels
+  assert(union_tree->data == 4);
+  assert(union_tree->left->data == 2);
+  assert(union_tree->right->data == 6);
+  print_binary_tree_inorder_route(union_tree);
+
+  BinaryTreeNode *intersection_tree = intersection_binary_tree(first, second);
+  assert(binary_tree_to_sorted_array(intersection_tree, values, 8) == 2);
+  assert(values[0] == 3 && values[1] == 4);
+  print_binary_tree_inorder_route(intersection_tree);
+
+  BinaryTreeNode *difference_tree = difference_binary_tree(first, second);
+  assert(binary_tree_to_sorted_array(difference_tree, values, 8) == 3);
+  assert(values[0] == 1 && values[1] == 2 && values[2] == 5);
+  print_binary_tree_inorder_route(difference_tree);
+
+  assert(intersection_binary_tree(first, NULL) == NULL);
+  assert(difference_binary_tree(NULL, second) == NULL);
+
+  // Given trees aren't modified
+  assert(count_binary_tree_nodes(first) == 6);
+  assert(first->right->right->data == 3);
+
+  assert(free_binary_tree(&union_tree) == 7);
+  assert(union_tree == NULL);
+  free_binary_tree(&intersection_tree);
+  free_binary_tree(&difference_tree);
+  free_binary_tree(&first);
+  free_binary_tree(&second);
+
+  printf("Set operations works!\n\n");
+}
+
+void test_parallel_set_operations_tree()
+{
+  printf("Testing parallel set operations\n");
+  int *values = (int *)malloc(sizeof(int) * 250000);
+
+  // Large enough to be merged by several threads, with a repeated value at the cut points
+  for (int i = 0; i < 200000; i++)
+  {
+    values[i] = i * 2;
+  }
+  BinaryTreeNode *first = build_binary_tree_from_sorted_array(values, 200000);
+
+  for (int i = 0; i < 100000; i++)
+  {
+    values[i] = (i / 2) * 6;
+  }
+  BinaryTreeNode *second = build_binary_tree_from_sorted_array(values, 100000);
+
+  BinaryTreeNode *union_tree = union_binary_tree(first, second);
+  assert(binary_tree_to_sorted_array(union_tree, values, 250000) == 200000);
+  for (int i = 0; i < 200000; i++)
+  {
+    assert(values[i] == i * 2);
+  }
+
+  BinaryTreeNode *intersection_tree = intersection_binary_tree(first, second);
+  assert(binary_tree_to_sorted_array(intersection_tree, values, 250000) == 50000);
+  for (int i = 0; i < 50000; i++)
+  {
+    assert(values[i] == i * 6);
+  }
+
+  BinaryTreeNode *difference_tree = difference_binary_tree(first, second);
+  assert(count_binary_tree_nodes(difference_tree) == 150000);
+  assert(find_binary_tree_node(difference_tree, 6) == NULL);
+  assert(find_binary_tree_node(difference_tree, 4) != NULL);
+
+  free_binary_tree(&union_tree);
+  free_binary_tree(&intersection_tree);
+  free_binary_tree(&difference_tree);
+  free_binary_tree(&first);
+  free_binary_tree(&second);
+  free(values);
+
+  printf("Parallel set operations works!\n\n");
+}
+
 void test_binary_tree()
 {
   // test_inorder_print_tree();
   test_delete_tree_node();
+  test_set_operations_tree();
+  test_parallel_set_operations_tree();
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "bloom_filter.h"
+
+#include <stdio.h>
+#include <assert.h>
+
+static void test_bloom_filter_queries()
+{
+  printf("Testing bloom filter queries\n");
+  BloomFilter *filter = create_bloom_filter(10000, 10);
+
+  assert(filter->hashes == 7);
+  assert(bloom_filter_memory_usage(filter) >= 10000 * 10 / 8);
+  assert(bloom_filter_false_positive_rate(filter) == 0.0);
+  assert(may_contain_bloom_filter(filter, 42) == 0);
+
+  for (int i = 0; i < 10000; i++)
+  {
+    add_bloom_filter(filter, i * 3);
+  }
+
+  // No false negatives
+  for (int i = 0; i < 10000; i++)
+  {
+    assert(may_contain_bloom_filter(filter, i * 3) == 1);
+  }
+
+  // About 1% of absent keys pass; blocked filters lose a bit of precision
+  int false_positives = 0;
+  for (int i = 0; i < 100000; i++)
+  {
+    false_positives += may_contain_bloom_filter(filter, -1 - i);
+  }
+  assert(false_positives < 3000);
+
+  double measured = false_positives / 100000.0;
+  double estimate = bloom_filter_false_positive_rate(filter);
+  printf("Measured false positive rate %.4f, estimated %.4f\n", measured, estimate);
+  assert(estimate > measured * 0.8 && estimate < measured * 1.2);
+
+  clear_bloom_filter(filter);
+  assert(may_contain_bloom_filter(filter, 3) == 0);
+  assert(filter->keys == 0);
+
+  assert(free_bloom_filter(&filter) == 0);
+  assert(filter == NULL);
+
+  printf("Bloom filter queries works!\n\n");
+}
+
+static void test_filtered_binary_tree()
+{
+  printf("Testing filtered binary tree\n");
+  BinaryTreeNode *head = NULL;
+  BloomFilter *filter = create_bloom_filter(1000, 10);
+
+  for (int i = 0; i < 1000; i++)
+  {
+    assert(insert_filtered_binary_tree_node(&head, filter, (i * 7919) % 1000) == 1);
+  }
+
+  for (int i = 0; i < 1000; i++)
+  {
+    BinaryTreeNode *node = find_filtered_binary_tree_node(head, filter, i);
+    assert(node != NULL && node->data == i);
+  }
+  assert(find_filtered_binary_tree_node(head, filter, 5000) == NULL);
+  assert(find_filtered_binary_tree_node(head, NULL, 500) != NULL);
+
+  // Deleting half the keys leaves stale bits until the filter is rebuilt
+  for (int i = 0; i < 499; i++)
+  {
+    head = delete_filtered_binary_tree_node(head, filter, i);
+  }
+  assert(filter->stale_keys == 499);
+  assert(may_contain_bloom_filter(filter, 0) == 1);
+
+  // A stale or absent value isn't counted again
+  assert(delete_filtered_binary_tree_node(head, filter, 0) == head);
+  assert(delete_filtered_binary_tree_node(head, filter, 5000) == head);
+  assert(filter->stale_keys == 499);
+
+  head = delete_filtered_binary_tree_node(head, filter, 499);
+  assert(filter->stale_keys == 0);
+  assert(filter->keys == 500);
+
+  int stale_positives = 0;
+  for (int i = 0; i < 500; i++)
+  {
+    assert(find_filtered_binary_tree_node(head, filter, i) == NULL);
+    assert(find_filtered_binary_tree_node(head, filter, i + 500) != NULL);
+    stale_positives += may_contain_bloom_filter(filter, i);
+  }
+  assert(stale_positives < 50);
+
+  assert(rebuild_bloom_filter(filter, head) == 500);
+
+  free_binary_tree(&head);
+  free_bloom_filter(&filter);
+
+  printf("Filtered binary tree works!\n\n");
+}
+
+void test_bloom_filter()
+{
+  test_bloom_filter_queries();
+  test_filtered_binary_tree();
+}
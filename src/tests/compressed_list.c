@@ -0,0 +1,200 @@
+#include "compressed_list.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+static void test_append_decode_compressed_list()
+{
+  printf("Testing compressed list append and decode\n");
+  CompressedList *list = create_compressed_list();
+  int count = 1000;
+  int *values = (int *)malloc(sizeof(int) * count);
+  int *decoded = (int *)malloc(sizeof(int) * count);
+
+  // Repeated values, small gaps, a huge gap and both extremes of int
+  values[0] = -2147483647 - 1;
+  for (int i = 1; i < count - 1; i++)
+  {
+    values[i] = (i < 300) ? -500 + i / 3 : (i < 600) ? 100000 + i * i : 2000000000 + i;
+  }
+  values[count - 1] = 2147483647;
+
+  for (int i = 0; i < count; i++)
+  {
+    assert(append_compressed_list(list, values[i]) == 1);
+  }
+  assert(append_compressed_list(list, 5) == 0);
+  assert(list->size == count);
+  assert(list->blocks_count == count / COMPRESSED_LIST_BLOCK_SIZE);
+
+  // First block jumps from INT_MIN to -500, the next one has gaps of 0 or 1
+  assert(list->blocks[0].bit_width == 31);
+  assert(list->blocks[1].bit_width == 1);
+
+  assert(compressed_list_to_array(list, decoded, count) == count);
+  for (int i = 0; i < count; i++)
+  {
+    assert(decoded[i] == values[i]);
+  }
+
+  // A short destination only takes the first values
+  assert(compressed_list_to_array(list, decoded, 200) == 200);
+  assert(decoded[199] == values[199]);
+
+  CompressedListIterator iterator;
+  int data = 0;
+  init_compressed_list_iterator(&iterator, list);
+  for (int i = 0; i < count; i++)
+  {
+    assert(next_compressed_list_iterator(&iterator, &data) == 1);
+    assert(data == values[i]);
+  }
+  assert(next_compressed_list_iterator(&iterator, &data) == 0);
+
+  // Whole blocks at once, the first call takes the rest of the current block
+  const int *block_values = NULL;
+  int scanned_values = 0;
+  init_compressed_list_iterator(&iterator, list);
+  assert(next_compressed_list_iterator(&iterator, &data) == 1);
+  scanned_values = 1;
+  for (int taken = 0; (taken = next_block_compressed_list_iterator(&iterator, &block_values)) > 0;)
+  {
+    assert(taken <= COMPRESSED_LIST_BLOCK_SIZE);
+    for (int i = 0; i < taken; i++)
+    {
+      assert(block_values[i] == values[scanned_values + i]);
+    }
+    scanned_values += taken;
+  }
+  assert(scanned_values == count);
+
+  free(values);
+  free(decoded);
+  assert(free_compressed_list(&list) == count);
+
+  // A gap from INT_MIN to INT_MAX needs the full 32 bits
+  list = create_compressed_list();
+  append_compressed_list(list, -2147483647 - 1);
+  for (int i = 1; i < COMPRESSED_LIST_BLOCK_SIZE; i++)
+  {
+    append_compressed_list(list, 2147483647);
+  }
+  assert(list->blocks_count == 1 && list->blocks[0].bit_width == 32);
+  init_compressed_list_iterator(&iterator, list);
+  assert(next_compressed_list_iterator(&iterator, &data) == 1 && data == -2147483647 - 1);
+  assert(next_compressed_list_iterator(&iterator, &data) == 1 && data == 2147483647);
+  free_compressed_list(&list);
+
+  // Widths 1 to 30, each block has one great gap in a different lane among gaps of 0 or 1,
+  // and the last block doesn't fill its final row of lanes
+  list = create_compressed_list();
+  count = 30 * COMPRESSED_LIST_BLOCK_SIZE + 7;
+  values = (int *)malloc(sizeof(int) * count);
+  decoded = (int *)malloc(sizeof(int) * count);
+  values[0] = -2147483647 - 1;
+  for (int i = 1; i < count; i++)
+  {
+    int block = i / COMPRESSED_LIST_BLOCK_SIZE;
+    int great_gap = (i % COMPRESSED_LIST_BLOCK_SIZE == 1 + (block * 37) % 127) && block < 30;
+    values[i] = values[i - 1] + (great_gap ? (1 << block) : i % 2);
+  }
+  for (int i = 0; i < count; i++)
+  {
+    append_compressed_list(list, values[i]);
+  }
+  for (int block = 1; block < 30; block++)
+  {
+    assert(list->blocks[block].bit_width == block + 1);
+  }
+  assert(compressed_list_to_array(list, decoded, count) == count);
+  for (int i = 0; i < count; i++)
+  {
+    assert(decoded[i] == values[i]);
+  }
+  free(values);
+  free(decoded);
+  free_compressed_list(&list);
+
+  printf("Compressed list append and decode works!\n\n");
+}
+
+static void test_seek_compressed_list()
+{
+  printf("Testing compressed list seeks and intersection\n");
+  CompressedList *multiples_of_3 = create_compressed_list();
+  CompressedList *multiples_of_5 = create_compressed_list();
+
+  for (int i = 0; i < 30000; i += 3)
+  {
+    append_compressed_list(multiples_of_3, i);
+  }
+  for (int i = 0; i < 30000; i += 5)
+  {
+    append_compressed_list(multiples_of_5, i);
+  }
+
+  CompressedListIterator iterator;
+  int data = 0;
+  init_compressed_list_iterator(&iterator, multiples_of_3);
+  assert(next_geq_compressed_list_iterator(&iterator, 10, &data) == 1 && data == 12);
+  assert(next_geq_compressed_list_iterator(&iterator, 12, &data) == 1 && data == 15);
+  assert(next_geq_compressed_list_iterator(&iterator, 20000, &data) == 1 && data == 20001);
+  assert(next_compressed_list_iterator(&iterator, &data) == 1 && data == 20004);
+  // Pending values at the end are reached too
+  assert(next_geq_compressed_list_iterator(&iterator, 29997, &data) == 1 && data == 29997);
+  assert(next_geq_compressed_list_iterator(&iterator, 29998, &data) == 0);
+  assert(next_compressed_list_iterator(&iterator, &data) == 0);
+
+  int *result = (int *)malloc(sizeof(int) * 2000);
+  assert(intersect_compressed_lists(multiples_of_3, multiples_of_5, result, 2000) == 2000);
+  for (int i = 0; i < 2000; i++)
+  {
+    assert(result[i] == i * 15);
+  }
+  assert(intersect_compressed_lists(multiples_of_3, multiples_of_5, result, 10) == 10);
+
+  // A list 100 times shorter seeks into the long one
+  CompressedList *multiples_of_300 = create_compressed_list();
+  for (int i = 0; i < 30000; i += 300)
+  {
+    append_compressed_list(multiples_of_300, i + 1);
+  }
+  append_compressed_list(multiples_of_300, 29997);
+  assert(intersect_compressed_lists(multiples_of_300, multiples_of_3, result, 2000) == 1);
+  assert(result[0] == 29997);
+  free_compressed_list(&multiples_of_300);
+
+  // Repeated values are taken once per matching pair
+  CompressedList *repeated = create_compressed_list();
+  CompressedList *other_repeated = create_compressed_list();
+  int repeated_values[] = {1, 1, 2, 3};
+  int other_repeated_values[] = {1, 2, 2};
+  for (int i = 0; i < 4; i++)
+  {
+    append_compressed_list(repeated, repeated_values[i]);
+  }
+  for (int i = 0; i < 3; i++)
+  {
+    append_compressed_list(other_repeated, other_repeated_values[i]);
+  }
+  assert(intersect_compressed_lists(repeated, other_repeated, result, 2000) == 2);
+  assert(result[0] == 1 && result[1] == 2);
+  free_compressed_list(&repeated);
+  free_compressed_list(&other_repeated);
+
+  // Small gaps take a few bits per value
+  assert(compressed_list_memory_usage(multiples_of_5) < 6000 * sizeof(int) / 4);
+
+  free(result);
+  free_compressed_list(&multiples_of_3);
+  free_compressed_list(&multiples_of_5);
+
+  printf("Compressed list seeks and intersection works!\n\n");
+}
+
+void test_compressed_list()
+{
+  test_append_decode_compressed_list();
+  test_seek_compressed_list();
+}
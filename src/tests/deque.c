@@ -0,0 +1,155 @@
+#include "deque.h"
+
+#include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+
+static void test_push_pop_deque()
+{
+  printf("Testing deque push and pop\n");
+  Deque *deque = create_deque(0);
+  int data = 0;
+
+  assert(deque != NULL);
+  assert(pop_front_deque(deque, &data) == 0);
+  assert(peek_back_deque(deque, &data) == 0);
+
+  // Mixing both ends forces the buffer to wrap and to grow
+  for (int i = 0; i < 20; i++)
+  {
+    push_back_deque(deque, i);
+    push_front_deque(deque, -i - 1);
+  }
+  // Current deque is [-20, ..., -1, 0, ..., 19]
+  assert(deque->size == 40);
+
+  assert(peek_front_deque(deque, &data) == 1 && data == -20);
+  assert(peek_back_deque(deque, &data) == 1 && data == 19);
+
+  for (int i = -20; i < 0; i++)
+  {
+    assert(pop_front_deque(deque, &data) == 1);
+    assert(data == i);
+  }
+
+  for (int i = 19; i >= 0; i--)
+  {
+    assert(pop_back_deque(deque, &data) == 1);
+    assert(data == i);
+  }
+
+  assert(deque->size == 0);
+  assert(free_deque(&deque) == 0);
+  assert(deque == NULL);
+
+  printf("Deque push and pop works!\n\n");
+}
+
+static void test_bulk_deque()
+{
+  printf("Testing deque bulk operations\n");
+  Deque *deque = create_deque(8);
+  int values[100];
+  int output[101];
+
+  for (int i = 0; i < 100; i++)
+  {
+    values[i] = i;
+  }
+
+  // Moves the head near the end of the buffer so the bulk copies wrap
+  enqueue_deque(deque, values, 6);
+  assert(dequeue_deque(deque, output, 5) == 5);
+  assert(output[4] == 4);
+
+  assert(enqueue_deque(deque, values, 5) == 5);
+  assert(deque->capacity == 8);
+  assert(dequeue_deque(deque, output, 100) == 6);
+  assert(output[0] == 5 && output[1] == 0 && output[5] == 4);
+
+  assert(enqueue_deque(deque, values, 100) == 100);
+  assert(deque->capacity == 128);
+  push_front_deque(deque, -1);
+  assert(dequeue_deque(deque, output, 101) == 101);
+  assert(output[0] == -1);
+  for (int i = 0; i < 100; i++)
+  {
+    assert(output[i + 1] == i);
+  }
+
+  free_deque(&deque);
+
+  printf("Deque bulk operations works!\n\n");
+}
+
+#define SPSC_ELEMENTS 100000
+
+static void *spsc_producer(void *argument)
+{
+  SpscQueue *queue = (SpscQueue *)argument;
+  int values[7];
+  int next = 0;
+
+  while (next < SPSC_ELEMENTS)
+  {
+    int count = 0;
+    while (count < 7 && next + count < SPSC_ELEMENTS)
+    {
+      values[count] = next + count;
+      count++;
+    }
+
+    // The queue is full when nothing is added, so we try again later
+    int added = enqueue_spsc_queue(queue, values, count);
+    next += added;
+
+    if (added == 0)
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+static void test_spsc_queue()
+{
+  printf("Testing single producer / single consumer queue\n");
+  SpscQueue *queue = create_spsc_queue(64);
+  int values[13];
+  int expected = 0;
+
+  assert(dequeue_spsc_queue(queue, values, 13) == 0);
+
+  pthread_t producer;
+  pthread_create(&producer, NULL, spsc_producer, queue);
+
+  while (expected < SPSC_ELEMENTS)
+  {
+    int removed = dequeue_spsc_queue(queue, values, 13);
+
+    for (int i = 0; i < removed; i++)
+    {
+      assert(values[i] == expected);
+      expected++;
+    }
+
+    if (removed == 0)
+    {
+      sched_yield();
+    }
+  }
+
+  pthread_join(producer, NULL);
+  assert(free_spsc_queue(&queue) == 0);
+
+  printf("Single producer / single consumer queue works!\n\n");
+}
+
+void test_deque()
+{
+  test_push_pop_deque();
+  test_bulk_deque();
+  test_spsc_queue();
+}
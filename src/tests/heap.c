@@ -0,0 +1,160 @@
+#include "heap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+static void test_push_pop_heap()
+{
+  printf("Testing heap push and pop\n");
+  int values[] = {15, 10, 20, 30, 9, 18, 12, 9, -4, 100, 0};
+
+  // Binary, default (4-ary) and wide heaps must behave the same
+  int arities[] = {2, 0, 7};
+  for (int a = 0; a < 3; a++)
+  {
+    Heap *min_heap = create_heap(MIN_HEAP, arities[a]);
+    Heap *max_heap = create_heap(MAX_HEAP, arities[a]);
+    int data = 0;
+
+    assert(pop_heap(min_heap, &data) == 0);
+    assert(peek_heap(min_heap, &data) == 0);
+
+    for (int i = 0; i < 11; i++)
+    {
+      assert(push_heap(min_heap, values[i]) >= 0);
+      assert(push_heap(max_heap, values[i]) >= 0);
+    }
+
+    assert(peek_heap(min_heap, &data) == 1 && data == -4);
+    assert(peek_heap(max_heap, &data) == 1 && data == 100);
+
+    int previous = -1000;
+    for (int i = 0; i < 11; i++)
+    {
+      assert(pop_heap(min_heap, &data) == 1);
+      assert(data >= previous);
+      previous = data;
+    }
+    assert(min_heap->size == 0);
+
+    previous = 1000;
+    for (int i = 0; i < 11; i++)
+    {
+      assert(pop_heap(max_heap, &data) == 1);
+      assert(data <= previous);
+      previous = data;
+    }
+
+    free_heap(&min_heap);
+    free_heap(&max_heap);
+  }
+
+  printf("Heap push and pop works!\n\n");
+}
+
+static void test_heapify_and_update()
+{
+  printf("Testing heapify and update key\n");
+  int values[200];
+
+  srand(3);
+  for (int i = 0; i < 200; i++)
+  {
+    values[i] = rand() % 1000;
+  }
+
+  Heap *heap = heapify_array(values, 200, MIN_HEAP, 0);
+  assert(heap->size == 200);
+
+  // Handle i belongs to values[i]: moves one value to the root and pushes another to the end
+  assert(update_heap_key(heap, 57, -1) == 1);
+  assert(update_heap_key(heap, 13, 5000) == 1);
+  assert(update_heap_key(heap, 500, 1) == 0);
+
+  int data = 0;
+  assert(pop_heap(heap, &data) == 1 && data == -1);
+  // Popped handles can't be updated
+  assert(update_heap_key(heap, 57, 3) == 0);
+
+  int previous = -1;
+  for (int i = 1; i < 199; i++)
+  {
+    pop_heap(heap, &data);
+    assert(data >= previous && data < 1000);
+    previous = data;
+  }
+
+  assert(pop_heap(heap, &data) == 1 && data == 5000);
+
+  // Handles of popped elements are given again
+  assert(push_heap(heap, 7) < 200);
+
+  free_heap(&heap);
+
+  printf("Heapify and update key works!\n\n");
+}
+
+static int compare_descending(const void *first, const void *second)
+{
+  return *(const int *)second - *(const int *)first;
+}
+
+static void test_top_k()
+{
+  printf("Testing top-k selection\n");
+  int values[1000];
+  int sorted[1000];
+  int result[10];
+
+  srand(5);
+  for (int i = 0; i < 1000; i++)
+  {
+    values[i] = rand() % 100000;
+    sorted[i] = values[i];
+  }
+  qsort(sorted, 1000, sizeof(int), compare_descending);
+
+  assert(select_top_k(values, 1000, 10, result) == 10);
+  for (int i = 0; i < 10; i++)
+  {
+    assert(result[i] == sorted[i]);
+  }
+
+  // Fewer values than k
+  assert(select_top_k(values, 3, 10, result) == 3);
+
+  // A MAX_HEAP keeps the smallest values of a stream
+  Heap *smallest = create_heap(MAX_HEAP, 0);
+  for (int i = 0; i < 1000; i++)
+  {
+    offer_heap_top_k(smallest, 5, values[i]);
+  }
+  int data = 0;
+  peek_heap(smallest, &data);
+  assert(smallest->size == 5);
+  assert(data == sorted[995]);
+  free_heap(&smallest);
+
+  // An evicted value loses its handle and the kept one gets a different one
+  Heap *greatest = create_heap(MIN_HEAP, 0);
+  int first_handle = offer_heap_top_k(greatest, 2, 10);
+  int second_handle = offer_heap_top_k(greatest, 2, 20);
+  assert(offer_heap_top_k(greatest, 2, 5) == -1);
+  int third_handle = offer_heap_top_k(greatest, 2, 30);
+  assert(third_handle >= 0 && third_handle != first_handle && third_handle != second_handle);
+  assert(update_heap_key(greatest, first_handle, 100) == 0);
+  assert(update_heap_key(greatest, third_handle, 15) == 1);
+  peek_heap(greatest, &data);
+  assert(data == 15);
+  free_heap(&greatest);
+
+  printf("Top-k selection works!\n\n");
+}
+
+void test_heap()
+{
+  test_push_pop_heap();
+  test_heapify_and_update();
+  test_top_k();
+}
@@ -0,0 +1,188 @@
+#include "lazy_binary_tree.h"
+
+#include <stdio.h>
+#include <assert.h>
+
+// Checks the order of the values and the counters of every subtree, returns the amount of nodes
+static int check_lazy_binary_tree(LazyBinaryTreeNode *node, int *dead_nodes)
+{
+  if (node == NULL)
+  {
+    *dead_nodes = 0;
+    return 0;
+  }
+
+  int left_dead_nodes = 0;
+  int right_dead_nodes = 0;
+  int nodes = 1 + check_lazy_binary_tree(node->left, &left_dead_nodes) +
+              check_lazy_binary_tree(node->right, &right_dead_nodes);
+
+  assert(node->left == NULL || node->left->data < node->data);
+  assert(node->right == NULL || node->right->data >= node->data);
+  *dead_nodes = left_dead_nodes + right_dead_nodes + node->deleted;
+  assert(node->nodes == nodes && node->dead_nodes == *dead_nodes);
+
+  return nodes;
+}
+
+static void test_lazy_binary_tree_tombstones()
+{
+  printf("Testing lazy binary tree tombstones\n");
+  LazyBinaryTree tree;
+  int values[8];
+  int dead_nodes = 0;
+
+  // Compaction disabled, deletes only leave tombstones
+  init_lazy_binary_tree(&tree, 0);
+
+  int inserted_values[] = {50, 30, 70, 30, 60, 80, 20};
+  for (int i = 0; i < 7; i++)
+  {
+    assert(insert_lazy_binary_tree_node(&tree, inserted_values[i]) == 1);
+  }
+
+  LazyBinaryTreeNode *head = tree.head;
+  assert(delete_lazy_binary_tree_node(&tree, 50) == 1);
+  assert(delete_lazy_binary_tree_node(&tree, 50) == 0);
+  assert(delete_lazy_binary_tree_node(&tree, 99) == 0);
+  assert(tree.head == head && head->deleted == 1);
+  assert(find_lazy_binary_tree_node(&tree, 50) == NULL);
+  assert(find_lazy_binary_tree_node(&tree, 70)->data == 70);
+
+  // Duplicate under a tombstone is still reachable
+  assert(delete_lazy_binary_tree_node(&tree, 30) == 1);
+  assert(find_lazy_binary_tree_node(&tree, 30) != NULL);
+  assert(count_lazy_binary_tree_live_nodes(&tree) == 5 && count_lazy_binary_tree_dead_nodes(&tree) == 2);
+  assert(lazy_binary_tree_dead_ratio(&tree) > 0.28 && lazy_binary_tree_dead_ratio(&tree) < 0.29);
+  assert(check_lazy_binary_tree(tree.head, &dead_nodes) == 7 && dead_nodes == 2);
+
+  int expected_values[] = {20, 30, 60, 70, 80};
+  assert(lazy_binary_tree_to_sorted_array(&tree, values, 8) == 5);
+  for (int i = 0; i < 5; i++)
+  {
+    assert(values[i] == expected_values[i]);
+  }
+
+  // Reinserting revives the tombstone in place
+  assert(insert_lazy_binary_tree_node(&tree, 50) == 1);
+  assert(tree.head == head && head->deleted == 0);
+  assert(count_lazy_binary_tree_live_nodes(&tree) == 6 && count_lazy_binary_tree_dead_nodes(&tree) == 1);
+  assert(check_lazy_binary_tree(tree.head, &dead_nodes) == 7 && dead_nodes == 1);
+
+  assert(free_lazy_binary_tree(&tree) == 7);
+  assert(tree.head == NULL);
+
+  printf("Lazy binary tree tombstones works!\n\n");
+}
+
+static void test_lazy_binary_tree_duplicates()
+{
+  printf("Testing lazy binary tree duplicates across compaction\n");
+  LazyBinaryTree tree;
+  int dead_nodes = 0;
+
+  init_lazy_binary_tree(&tree, 0);
+
+  insert_lazy_binary_tree_node(&tree, 3);
+  for (int i = 0; i < 3; i++)
+  {
+    insert_lazy_binary_tree_node(&tree, 5);
+  }
+  insert_lazy_binary_tree_node(&tree, 8);
+
+  // The first copy of the middle value is the root, so every copy stays reachable
+  assert(compact_lazy_binary_tree(&tree) == 0);
+  assert(tree.head->data == 5 && tree.head->left->data == 3);
+  for (int i = 0; i < 3; i++)
+  {
+    assert(delete_lazy_binary_tree_node(&tree, 5) == 1);
+  }
+  assert(delete_lazy_binary_tree_node(&tree, 5) == 0);
+  assert(count_lazy_binary_tree_live_nodes(&tree) == 2);
+
+  // The first inserts revive the tombstones, and a long run of equal values is relinked by
+  // the loop of the rebuild instead of its recursion
+  for (int i = 0; i < 10000; i++)
+  {
+    insert_lazy_binary_tree_node(&tree, 5);
+  }
+  assert(count_lazy_binary_tree_dead_nodes(&tree) == 0);
+  assert(delete_lazy_binary_tree_node(&tree, 3) == 1);
+  assert(compact_lazy_binary_tree(&tree) == 1);
+  assert(check_lazy_binary_tree(tree.head, &dead_nodes) == 10001 && dead_nodes == 0);
+  assert(delete_lazy_binary_tree_node(&tree, 5) == 1);
+  assert(find_lazy_binary_tree_node(&tree, 5) != NULL);
+  assert(find_lazy_binary_tree_node(&tree, 8) != NULL);
+
+  assert(free_lazy_binary_tree(&tree) == 10001);
+
+  printf("Lazy binary tree duplicates across compaction works!\n\n");
+}
+
+static void test_lazy_binary_tree_compaction()
+{
+  printf("Testing lazy binary tree compaction\n");
+  LazyBinaryTree tree;
+  static int values[10000];
+  int dead_nodes = 0;
+
+  init_lazy_binary_tree(&tree, 0.5);
+
+  // Sorted inserts make a degenerate tree, a manual compaction balances it
+  for (int i = 0; i < 10000; i++)
+  {
+    insert_lazy_binary_tree_node(&tree, i);
+  }
+  assert(compact_lazy_binary_tree(&tree) == 0);
+  assert(tree.head->data == 5000);
+
+  LazyBinaryTreeNode *head = tree.head;
+  LazyBinaryTreeNode *survivor = find_lazy_binary_tree_node(&tree, 9999);
+
+  // Deleting a leaf only marks it, a one-node subtree is too small to be compacted
+  LazyBinaryTreeNode *leaf = tree.head;
+  while (leaf->left != NULL || leaf->right != NULL)
+  {
+    leaf = (leaf->left != NULL) ? leaf->left : leaf->right;
+  }
+  assert(delete_lazy_binary_tree_node(&tree, leaf->data) == 1);
+  assert(leaf->deleted == 1 && leaf->nodes == 1 && leaf->dead_nodes == 1);
+  assert(tree.head->dead_nodes == 1 && count_lazy_binary_tree_dead_nodes(&tree) == 1);
+  assert(insert_lazy_binary_tree_node(&tree, leaf->data) == 1);
+  assert(leaf->deleted == 0 && count_lazy_binary_tree_dead_nodes(&tree) == 0);
+
+  // Deletes only compact the small subtrees of their path, never the root
+  for (int i = 0; i < 1000; i++)
+  {
+    assert(delete_lazy_binary_tree_node(&tree, i) == 1);
+    assert(lazy_binary_tree_dead_ratio(&tree) < 0.5);
+  }
+  assert(tree.head == head && find_lazy_binary_tree_node(&tree, 9999) == survivor);
+  assert(count_lazy_binary_tree_live_nodes(&tree) == 9000);
+  assert(count_lazy_binary_tree_dead_nodes(&tree) < 500);
+  assert(check_lazy_binary_tree(tree.head, &dead_nodes) == 9000 + dead_nodes);
+
+  assert(lazy_binary_tree_to_sorted_array(&tree, values, 10000) == 9000);
+  for (int i = 0; i < 9000; i++)
+  {
+    assert(values[i] == i + 1000);
+  }
+
+  // Manual compaction removes the remaining tombstones
+  int remaining_dead_nodes = count_lazy_binary_tree_dead_nodes(&tree);
+  assert(compact_lazy_binary_tree(&tree) == remaining_dead_nodes);
+  assert(compact_lazy_binary_tree(&tree) == 0);
+  assert(find_lazy_binary_tree_node(&tree, 999) == NULL);
+  assert(find_lazy_binary_tree_node(&tree, 9999) == survivor);
+
+  assert(free_lazy_binary_tree(&tree) == 9000);
+
+  printf("Lazy binary tree compaction works!\n\n");
+}
+
+void test_lazy_binary_tree()
+{
+  test_lazy_binary_tree_tombstones();
+  test_lazy_binary_tree_duplicates();
+  test_lazy_binary_tree_compaction();
+}
@@ -72,9 +72,153 @@ static void test_delete_nodes()
   free_linked_list(&head);
 }
 
+static void test_set_operations()
+{
+  LinkedListNode *first = NULL;
+  LinkedListNode *second = NULL;
+  printf("Testing Set Operations\n");
+
+  push_linked_list(&first, 1);
+  push_linked_list(&first, 3);
+  push_linked_list(&first, 3);
+  push_linked_list(&first, 5);
+  push_linked_list(&second, 2);
+  push_linked_list(&second, 3);
+  push_linked_list(&second, 6);
+  // first is [1, 3, 3, 5] and second is [2, 3, 6]
+
+  LinkedListNode *union_list = union_linked_list(first, second);
+  LinkedListNode *intersection_list = intersection_linked_list(first, second);
+  LinkedListNode *difference_list = difference_linked_list(first, second);
+
+  print_linked_list(union_list);
+  print_linked_list(intersection_list);
+  print_linked_list(difference_list);
+
+  int expected_union[] = {1, 2, 3, 5, 6};
+  LinkedListNode *current_node = union_list;
+  for (int i = 0; i < 5; i++)
+  {
+    assert(current_node->data == expected_union[i]);
+    current_node = current_node->next;
+  }
+  assert(current_node == NULL);
+
+  assert(intersection_list->data == 3);
+  assert(intersection_list->next == NULL);
+
+  assert(difference_list->data == 1);
+  assert(difference_list->next->data == 5);
+  assert(difference_list->next->next == NULL);
+
+  assert(intersection_linked_list(first, NULL) == NULL);
+
+  printf("Set operations works!\n\n");
+  free_linked_list(&union_list);
+  free_linked_list(&intersection_list);
+  free_linked_list(&difference_list);
+  free_linked_list(&first);
+  free_linked_list(&second);
+}
+
+static void assert_linked_list_equals(LinkedListNode *head, const int *expected, int size)
+{
+  for (int i = 0; i < size; i++)
+  {
+    assert(head != NULL);
+    assert(head->data == expected[i]);
+    head = head->next;
+  }
+
+  assert(head == NULL);
+}
+
+static void test_relinking_operations()
+{
+  LinkedListNode *head = NULL;
+  printf("Testing Relinking Operations\n");
+
+  int values[] = {5, 1, 4, 4, 2, 8, 0, 3, 7, 6};
+  for (int i = 0; i < 10; i++)
+  {
+    push_linked_list(&head, values[i]);
+  }
+  LinkedListNode *first_node = head;
+
+  sort_linked_list(&head);
+  print_linked_list(head);
+  int sorted[] = {0, 1, 2, 3, 4, 4, 5, 6, 7, 8};
+  assert_linked_list_equals(head, sorted, 10);
+
+  // Nodes are relinked, not reallocated
+  int found = 0;
+  for (LinkedListNode *node = head; node != NULL; node = node->next)
+  {
+    found |= node == first_node;
+  }
+  assert(found);
+
+  // Already sorted lists need a single pass and no merge
+  assert(sort_linked_list(&head) == 0);
+
+  assert(reverse_linked_list(&head) == 10);
+  int reversed[] = {8, 7, 6, 5, 4, 4, 3, 2, 1, 0};
+  assert_linked_list_equals(head, reversed, 10);
+
+  LinkedListNode *second_part = split_linked_list(&head, 4);
+  int first_half[] = {8, 7, 6, 5};
+  int second_half[] = {4, 4, 3, 2, 1, 0};
+  assert_linked_list_equals(head, first_half, 4);
+  assert_linked_list_equals(second_part, second_half, 6);
+  assert(split_linked_list(&head, 4) == NULL);
+
+  concat_linked_list(&second_part, take_last_from_linked_list(second_part), head);
+  head = second_part;
+  int concatenated[] = {4, 4, 3, 2, 1, 0, 8, 7, 6, 5};
+  assert_linked_list_equals(head, concatenated, 10);
+
+  sort_linked_list(&head);
+  assert_linked_list_equals(head, sorted, 10);
+  free_linked_list(&head);
+
+  sort_linked_list(&head);
+  assert(head == NULL);
+
+  printf("Relinking operations works!\n\n");
+}
+
+static void test_merge_sorted_lists()
+{
+  LinkedListNode *lists[4] = {NULL, NULL, NULL, NULL};
+  printf("Testing K-Way Merge\n");
+
+  for (int i = 0; i < 12; i++)
+  {
+    // lists[3] stays empty
+    push_linked_list(&lists[i % 3], i);
+  }
+
+  LinkedListNode *merged = merge_sorted_linked_lists(lists, 4);
+  print_linked_list(merged);
+
+  int expected[12];
+  for (int i = 0; i < 12; i++)
+  {
+    expected[i] = i;
+  }
+  assert_linked_list_equals(merged, expected, 12);
+  assert(lists[0] == NULL && lists[1] == NULL && lists[2] == NULL);
+
+  printf("K-Way merge works!\n\n");
+  free_linked_list(&merged);
+}
+
 void test_linked_list()
 {
   // test_create_node();
   // test_push_nodes();
   // test_delete_nodes();
+  test_set_operations();
+  test_relinking_operations();
+  test_merge_sorted_lists();
 }
\ No newline at end of file
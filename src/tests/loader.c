@@ -0,0 +1,147 @@
+#include "loader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+
+// Checks that every value is within the bounds of its ancestors, equal values only at the
+// right side, and returns the amount of nodes
+static int check_loaded_binary_tree(BinaryTreeNode *node, long long low, long long high)
+{
+  if (node == NULL)
+  {
+    return 0;
+  }
+
+  assert(node->data >= low && node->data < high);
+
+  return 1 + check_loaded_binary_tree(node->left, low, node->data) +
+         check_loaded_binary_tree(node->right, node->data, high);
+}
+
+static void test_loader_parsing()
+{
+  printf("Testing loader parsing\n");
+  int keys[16];
+
+  const char *text = "12 -7\n123456789,2147483647\t-2147483648 - x 00000000000042 0 9876543210123";
+  int expected_keys[] = {12, -7, 123456789, 2147483647, -2147483647 - 1, 42, 0};
+
+  // The last key doesn't fit in an int, it wraps around but still counts
+  assert(parse_decimal_keys(text, strlen(text), keys, 16) == 8);
+  for (int i = 0; i < 7; i++)
+  {
+    assert(keys[i] == expected_keys[i]);
+  }
+
+  // Stops at capacity and doesn't need a null terminator
+  assert(parse_decimal_keys(text, 5, keys, 16) == 2);
+  assert(keys[1] == -7);
+  assert(parse_decimal_keys(text, strlen(text), keys, 3) == 3);
+  assert(parse_decimal_keys("", 0, keys, 16) == 0);
+  assert(parse_decimal_keys(" - ,", 4, keys, 16) == 0);
+
+  unsigned char bytes[] = {1, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0x78, 0x56, 0x34, 0x12, 9};
+  assert(decode_binary_keys(bytes, sizeof(bytes), keys, 16) == 3);
+  assert(keys[0] == 1 && keys[1] == -1 && keys[2] == 0x12345678);
+  assert(decode_binary_keys(bytes, sizeof(bytes), keys, 1) == 1);
+
+  int values[] = {5, -3, 2147483647, 0, -2147483647 - 1, 5, 70000, -70000};
+  int sorted_values[] = {-2147483647 - 1, -70000, -3, 0, 5, 5, 70000, 2147483647};
+  assert(sort_keys(values, 8) == 0);
+  for (int i = 0; i < 8; i++)
+  {
+    assert(values[i] == sorted_values[i]);
+  }
+
+  printf("Loader parsing works!\n\n");
+}
+
+static void test_loader_files()
+{
+  printf("Testing loader files\n");
+  char text_path[] = "/tmp/loader_text_XXXXXX";
+  char binary_path[] = "/tmp/loader_binary_XXXXXX";
+  int text_descriptor = mkstemp(text_path);
+  int binary_descriptor = mkstemp(binary_path);
+  assert(text_descriptor >= 0 && binary_descriptor >= 0);
+
+  FILE *text_file = fdopen(text_descriptor, "w");
+  FILE *binary_file = fdopen(binary_descriptor, "wb");
+  for (int i = 0; i < 10000; i++)
+  {
+    int key = (i * 7919) % 10000 - 5000;
+    fprintf(text_file, "%d\n", key);
+    fwrite(&key, sizeof(int), 1, binary_file);
+  }
+  fclose(text_file);
+  fclose(binary_file);
+
+  int count = 0;
+  int *keys = load_keys(binary_path, LOADER_BINARY, &count);
+  assert(count == 10000);
+  assert(keys[0] == -5000 && keys[1] == 7919 % 10000 - 5000);
+  free(keys);
+
+  // List keeps the order of the input
+  LinkedListNode *list = load_linked_list(text_path, LOADER_TEXT, &count);
+  assert(count == 10000);
+  LinkedListNode *node = list;
+  for (int i = 0; i < 10000; i++, node = node->next)
+  {
+    assert(node->data == (i * 7919) % 10000 - 5000);
+  }
+  assert(node == NULL);
+  assert(free_linked_list(&list) == 10000);
+
+  // Tree is balanced and sorted
+  BinaryTreeNode *tree = load_binary_tree(binary_path, LOADER_BINARY, &count);
+  assert(count == 10000);
+  assert(tree->data == 0);
+  int values[10000];
+  assert(binary_tree_to_sorted_array(tree, values, 10000) == 10000);
+  for (int i = 0; i < 10000; i++)
+  {
+    assert(values[i] == i - 5000);
+  }
+  assert(free_binary_tree(&tree) == 10000);
+
+  // Duplicates go to the right of their first copy, so every copy can be found and removed
+  text_file = fopen(text_path, "w");
+  for (int i = 0; i < 1000; i++)
+  {
+    fprintf(text_file, "%d %d\n", i % 10, 7);
+  }
+  fclose(text_file);
+  tree = load_binary_tree(text_path, LOADER_TEXT, &count);
+  assert(count == 2000);
+  assert(check_loaded_binary_tree(tree, -2147483648LL, 2147483648LL) == 2000);
+  assert(tree->data == 7 && (tree->left == NULL || tree->left->data < 7));
+  for (int i = 0; i < 100; i++)
+  {
+    assert(remove_binary_tree_node(&tree, 3) == 1);
+  }
+  assert(find_binary_tree_node(tree, 3) == NULL);
+  for (int i = 0; i < 1100; i++)
+  {
+    assert(remove_binary_tree_node(&tree, 7) == 1);
+  }
+  assert(find_binary_tree_node(tree, 7) == NULL);
+  assert(check_loaded_binary_tree(tree, -2147483648LL, 2147483648LL) == 800);
+  assert(free_binary_tree(&tree) == 800);
+
+  assert(load_keys("/tmp/loader_missing/file", LOADER_TEXT, &count) == NULL && count == 0);
+
+  unlink(text_path);
+  unlink(binary_path);
+
+  printf("Loader files works!\n\n");
+}
+
+void test_loader()
+{
+  test_loader_parsing();
+  test_loader_files();
+}
@@ -0,0 +1,159 @@
+#include "persistent_binary_tree.h"
+
+#include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
+
+static int count_sorted_nodes(PersistentBinaryTreeNode *node, int *previous, int *sorted)
+{
+  if (node == NULL)
+  {
+    return 0;
+  }
+
+  int counted_nodes = count_sorted_nodes(node->left, previous, sorted);
+
+  if (node->data < *previous)
+  {
+    *sorted = 0;
+  }
+  *previous = node->data;
+
+  return counted_nodes + 1 + count_sorted_nodes(node->right, previous, sorted);
+}
+
+static int count_nodes(PersistentBinaryTreeNode *root)
+{
+  int previous = -2147483647 - 1;
+  int sorted = 1;
+  int counted_nodes = count_sorted_nodes(root, &previous, &sorted);
+
+  assert(sorted);
+
+  return counted_nodes;
+}
+
+static void test_path_copying()
+{
+  printf("Testing persistent versions\n");
+
+  PersistentBinaryTreeNode *versions[8];
+  int values[] = {15, 10, 20, 30, 9, 18, 12};
+
+  versions[0] = NULL;
+  for (int i = 0; i < 7; i++)
+  {
+    assert(insert_persistent_binary_tree_node(versions[i], values[i], &versions[i + 1]) == 1);
+  }
+
+  // Every version keeps its own amount of nodes
+  for (int i = 0; i < 8; i++)
+  {
+    assert(count_nodes(versions[i]) == i);
+  }
+
+  /**
+   * Last version looks like:
+   *        15
+   *      10   20
+   *     9  12 18 30
+   */
+  // Inserting 12 only copied 15 and 10, so the right side is shared
+  assert(versions[7]->right == versions[6]->right);
+  assert(versions[7]->left != versions[6]->left);
+  assert(versions[7]->left->left == versions[6]->left->left);
+
+  // Delete node with two children: 10 is replaced by 9
+  PersistentBinaryTreeNode *deleted = NULL;
+  assert(delete_persistent_binary_tree_node(versions[7], 10, &deleted) == 1);
+  assert(count_nodes(deleted) == 6);
+  assert(deleted->left->data == 9);
+  assert(deleted->left->right == versions[7]->left->right);
+  assert(deleted->right == versions[7]->right);
+  assert(search_persistent_binary_tree_node(deleted, 10) == NULL);
+  assert(search_persistent_binary_tree_node(versions[7], 10) != NULL);
+
+  // Delete the root and a value that doesn't exist
+  PersistentBinaryTreeNode *without_root = NULL;
+  assert(delete_persistent_binary_tree_node(deleted, 15, &without_root) == 1);
+  assert(without_root->data == 12);
+  assert(count_nodes(without_root) == 5);
+
+  PersistentBinaryTreeNode *same = NULL;
+  assert(delete_persistent_binary_tree_node(without_root, 100, &same) == 0);
+  assert(same == without_root);
+  assert(release_persistent_binary_tree(same) == 0);
+
+  // Releasing old versions only frees the nodes that aren't shared anymore
+  for (int i = 1; i < 7; i++)
+  {
+    release_persistent_binary_tree(versions[i]);
+  }
+  assert(count_nodes(versions[7]) == 7);
+  assert(release_persistent_binary_tree(deleted) == 2);
+  assert(count_nodes(without_root) == 5);
+  assert(release_persistent_binary_tree(versions[7]) == 4);
+  assert(release_persistent_binary_tree(without_root) == 5);
+
+  printf("Persistent versions works!\n\n");
+}
+
+#define WRITES 2000
+
+static void *writer_thread(void *argument)
+{
+  PersistentBinaryTree *tree = (PersistentBinaryTree *)argument;
+
+  for (int i = 0; i < WRITES; i++)
+  {
+    insert_persistent_binary_tree(tree, (i * 7919) % WRITES);
+  }
+
+  for (int i = 0; i < WRITES; i += 2)
+  {
+    delete_persistent_binary_tree(tree, i);
+  }
+
+  return NULL;
+}
+
+static void test_concurrent_snapshots()
+{
+  printf("Testing persistent snapshots\n");
+
+  PersistentBinaryTree tree;
+  assert(init_persistent_binary_tree(&tree) == 1);
+
+  pthread_t writer;
+  pthread_create(&writer, NULL, writer_thread, &tree);
+
+  // Every snapshot is a consistent sorted tree that never changes while it's read
+  for (int i = 0; i < 200; i++)
+  {
+    PersistentBinaryTreeNode *snapshot = snapshot_persistent_binary_tree(&tree);
+    int counted_nodes = count_nodes(snapshot);
+    assert(counted_nodes <= WRITES);
+    assert(count_nodes(snapshot) == counted_nodes);
+    release_persistent_binary_tree(snapshot);
+  }
+
+  pthread_join(writer, NULL);
+
+  PersistentBinaryTreeNode *snapshot = snapshot_persistent_binary_tree(&tree);
+  assert(count_nodes(snapshot) == WRITES / 2);
+  assert(search_persistent_binary_tree_node(snapshot, 1) != NULL);
+  assert(search_persistent_binary_tree_node(snapshot, 2) == NULL);
+
+  // The snapshot outlives the tree
+  destroy_persistent_binary_tree(&tree);
+  assert(count_nodes(snapshot) == WRITES / 2);
+  assert(release_persistent_binary_tree(snapshot) == WRITES / 2);
+
+  printf("Persistent snapshots works!\n\n");
+}
+
+void test_persistent_binary_tree()
+{
+  test_path_copying();
+  test_concurrent_snapshots();
+}
@@ -0,0 +1,148 @@
+#include "radix_tree.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+static int compare_ints(const void *first, const void *second)
+{
+  int a = *(const int *)first;
+  int b = *(const int *)second;
+
+  return (a > b) - (a < b);
+}
+
+static void test_insert_search_radix_tree()
+{
+  printf("Testing radix tree insert and search\n");
+  RadixTree *tree = create_radix_tree();
+
+  // Negative keys, extremes and keys that share long prefixes
+  int values[] = {15, -1, 0, 2147483647, -2147483647 - 1, 256, 257, 65536, 65537, 16777216, -256};
+
+  for (int i = 0; i < 11; i++)
+  {
+    assert(insert_radix_tree(tree, values[i]) == 1);
+  }
+  assert(insert_radix_tree(tree, 256) == 0);
+  assert(tree->size == 11);
+
+  for (int i = 0; i < 11; i++)
+  {
+    assert(search_radix_tree(tree, values[i]) == 1);
+  }
+  assert(search_radix_tree(tree, 1) == 0);
+  assert(search_radix_tree(tree, 258) == 0);
+  assert(search_radix_tree(tree, -2) == 0);
+
+  int sorted[11];
+  assert(radix_tree_to_sorted_array(tree, sorted, 11) == 11);
+  qsort(values, 11, sizeof(int), compare_ints);
+  for (int i = 0; i < 11; i++)
+  {
+    assert(sorted[i] == values[i]);
+  }
+
+  assert(free_radix_tree(&tree) == 11);
+  assert(tree == NULL);
+
+  printf("Radix tree insert and search works!\n\n");
+}
+
+static void test_grow_shrink_radix_tree()
+{
+  printf("Testing radix tree node growth and deletion\n");
+  RadixTree *tree = create_radix_tree();
+
+  // 0..4095 fills Node256 at the last byte, the strides make Node4/16/48 on other levels
+  for (int i = 0; i < 4096; i++)
+  {
+    assert(insert_radix_tree(tree, i) == 1);
+  }
+  for (int i = 0; i < 40; i++)
+  {
+    assert(insert_radix_tree(tree, 1000000 + i * 65536) == 1);
+  }
+
+  int key = 0;
+  int previous = -1;
+  int counted_keys = 0;
+  RadixTreeIterator iterator;
+  init_radix_tree_iterator(&iterator, tree);
+  while (next_radix_tree_iterator(&iterator, &key))
+  {
+    assert(key > previous);
+    previous = key;
+    counted_keys++;
+  }
+  assert(counted_keys == 4136);
+
+  // Deleting most keys shrinks every node type back down
+  assert(delete_radix_tree(tree, 5000) == 0);
+  for (int i = 0; i < 4096; i++)
+  {
+    if (i % 97 != 0)
+    {
+      assert(delete_radix_tree(tree, i) == 1);
+    }
+  }
+  for (int i = 1; i < 40; i++)
+  {
+    assert(delete_radix_tree(tree, 1000000 + i * 65536) == 1);
+  }
+  assert(delete_radix_tree(tree, 1) == 0);
+
+  for (int i = 0; i < 4096; i++)
+  {
+    assert(search_radix_tree(tree, i) == (i % 97 == 0));
+  }
+  assert(search_radix_tree(tree, 1000000) == 1);
+  assert(tree->size == 43 + 1);
+
+  // Empties the tree
+  for (int i = 0; i < 4096; i += 97)
+  {
+    assert(delete_radix_tree(tree, i) == 1);
+  }
+  assert(delete_radix_tree(tree, 1000000) == 1);
+  assert(tree->root == NULL);
+  assert(tree->size == 0);
+
+  free_radix_tree(&tree);
+
+  printf("Radix tree node growth and deletion works!\n\n");
+}
+
+static void test_random_radix_tree()
+{
+  printf("Testing radix tree with random keys\n");
+  RadixTree *tree = create_radix_tree();
+
+  // Multiplying by an odd constant is a bijection, so the keys are spread but never repeat
+  for (unsigned int i = 0; i < 20000; i++)
+  {
+    assert(insert_radix_tree(tree, (int)(i * 2654435761u)) == 1);
+  }
+  assert(tree->size == 20000);
+
+  for (unsigned int i = 0; i < 20000; i += 2)
+  {
+    assert(delete_radix_tree(tree, (int)(i * 2654435761u)) == 1);
+  }
+  for (unsigned int i = 0; i < 20000; i++)
+  {
+    assert(search_radix_tree(tree, (int)(i * 2654435761u)) == (int)(i % 2));
+  }
+  assert(tree->size == 10000);
+
+  free_radix_tree(&tree);
+
+  printf("Radix tree with random keys works!\n\n");
+}
+
+void test_radix_tree()
+{
+  test_insert_search_radix_tree();
+  test_grow_shrink_radix_tree();
+  test_random_radix_tree();
+}
@@ -0,0 +1,166 @@
+#include "treap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+// Checks the order of the values and the priorities, returns the amount of nodes
+static int check_treap(TreapNode *node, int *previous)
+{
+  if (node == NULL)
+  {
+    return 0;
+  }
+
+  assert(node->left == NULL || node->left->priority <= node->priority);
+  assert(node->right == NULL || node->right->priority <= node->priority);
+
+  int counted_nodes = check_treap(node->left, previous);
+  assert(node->data >= *previous);
+  *previous = node->data;
+
+  return counted_nodes + 1 + check_treap(node->right, previous);
+}
+
+static int count_treap(TreapNode *root)
+{
+  int previous = -2147483647 - 1;
+
+  return check_treap(root, &previous);
+}
+
+static int height_treap(TreapNode *node)
+{
+  if (node == NULL)
+  {
+    return 0;
+  }
+
+  int left_height = height_treap(node->left);
+  int right_height = height_treap(node->right);
+
+  return 1 + (left_height > right_height ? left_height : right_height);
+}
+
+static void test_insert_delete_treap()
+{
+  printf("Testing treap insert and delete\n");
+  TreapNode *root = NULL;
+
+  for (int i = 0; i < 1000; i++)
+  {
+    // Sorted input would make a binary search tree a list
+    assert(insert_treap_node(&root, i) == 1);
+  }
+  insert_treap_node(&root, 500);
+  assert(count_treap(root) == 1001);
+
+  assert(delete_treap_node(&root, 500) == 1);
+  assert(search_treap_node(root, 500) != NULL);
+  assert(delete_treap_node(&root, 500) == 1);
+  assert(search_treap_node(root, 500) == NULL);
+  assert(delete_treap_node(&root, 500) == 0);
+  assert(count_treap(root) == 999);
+
+  assert(free_treap(&root) == 999);
+  assert(root == NULL);
+
+  // Copies of a value get their own priorities, so they don't chain
+  for (int i = 0; i < 20000; i++)
+  {
+    insert_treap_node(&root, 7);
+  }
+  assert(height_treap(root) < 100);
+  assert(delete_treap_node(&root, 7) == 1);
+  assert(count_treap(root) == 19999);
+  assert(free_treap(&root) == 19999);
+
+  printf("Treap insert and delete works!\n\n");
+}
+
+static void test_split_join_treap()
+{
+  printf("Testing treap split and join\n");
+  TreapNode *root = NULL;
+
+  for (int i = 0; i < 100; i++)
+  {
+    insert_treap_node(&root, (i * 37) % 100);
+  }
+
+  TreapNode *left = NULL;
+  TreapNode *right = NULL;
+  split_treap(root, 40, &left, &right);
+
+  int previous = -1;
+  assert(check_treap(left, &previous) == 40);
+  assert(previous == 39);
+  previous = 40;
+  assert(check_treap(right, &previous) == 60);
+
+  // Every shard can be changed on its own before joining
+  insert_treap_node(&left, 0);
+  delete_treap_node(&right, 99);
+
+  root = join_treap(left, right);
+  assert(count_treap(root) == 100);
+  assert(search_treap_node(root, 99) == NULL);
+
+  assert(join_treap(NULL, root) == root);
+  split_treap(root, -5, &left, &right);
+  assert(left == NULL && right == root);
+
+  free_treap(&root);
+
+  printf("Treap split and join works!\n\n");
+}
+
+static void test_bulk_treap()
+{
+  printf("Testing treap parallel bulk operations\n");
+  int count = 100000;
+  int *values = (int *)malloc(sizeof(int) * count);
+  TreapNode *root = NULL;
+
+  srand(23);
+  for (int i = 0; i < count; i++)
+  {
+    values[i] = rand() % 50000;
+  }
+
+  for (int i = 0; i < 1000; i++)
+  {
+    insert_treap_node(&root, -i);
+  }
+
+  assert(bulk_insert_treap(&root, values, count, 4) == count);
+  assert(count_treap(root) == count + 1000);
+
+  // Every value deletes one node: one copy of the first half of the values, then the pre-existing negatives
+  assert(bulk_delete_treap(&root, values, count / 2, 8) == count / 2);
+  for (int i = 0; i < 1000; i++)
+  {
+    values[i] = -i;
+  }
+  assert(bulk_delete_treap(&root, values, 1000, 1) == 1000);
+  assert(count_treap(root) == count - count / 2);
+
+  for (int i = count / 2; i < count; i++)
+  {
+    assert(search_treap_node(root, values[i]) != NULL);
+  }
+
+  assert(bulk_delete_treap(&root, values + count / 2, count - count / 2, 3) == count - count / 2);
+  assert(root == NULL);
+
+  free(values);
+
+  printf("Treap parallel bulk operations works!\n\n");
+}
+
+void test_treap()
+{
+  test_insert_delete_treap();
+  test_split_join_treap();
+  test_bulk_treap();
+}
@@ -0,0 +1,533 @@
+#include "../../include/treap.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Below this amount of values a shard is processed by the current thread
+#define TREAP_MIN_SHARD 1024
+
+// Amount of nodes created so far, every node hashes its own number into its priority
+static atomic_uint treap_nodes_created;
+
+/**
+ * @brief computes the priority of a new node
+ *
+ * @returns pseudo random priority
+ *
+ * A mixing hash of a node counter gives random looking priorities that are different for
+ * every copy of a value, so repeated values don't chain. The counter is the only shared
+ * state, so nodes can be created from several threads at once
+ */
+static unsigned int treap_priority()
+{
+  unsigned int hash = atomic_fetch_add_explicit(&treap_nodes_created, 1, memory_order_relaxed);
+
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+
+/**
+ * @brief init a treap node
+ *
+ * @param data value of the node
+ *
+ * @returns created node
+ *
+ * Special cases:
+ *
+ * 1. If node can't be allocated in memory, then this function will return a null pointer
+ */
+TreapNode *create_treap_node(int data)
+{
+  TreapNode *new_node = (TreapNode *)malloc(sizeof(TreapNode));
+
+  /**
+   * Security measure: if node can't be allocated, then we must return null
+   */
+  if (new_node == NULL)
+  {
+    return NULL;
+  }
+
+  new_node->data = data;
+  new_node->priority = treap_priority();
+  new_node->left = NULL;
+  new_node->right = NULL;
+
+  return new_node;
+}
+
+/**
+ * @brief splits a treap by a key
+ *
+ * @param root Treap root
+ * @param key split key
+ * @param left variable where the treap with the values lower than key is stored
+ * @param right variable where the treap with the values equal or greater than key is stored
+ *
+ * Only the nodes on the path of the key are relinked, so this function runs in O(log n).
+ * The given treap can't be used after the call
+ */
+void split_treap(TreapNode *root, int key, TreapNode **left, TreapNode **right)
+{
+  TreapNode **left_slot = left;
+  TreapNode **right_slot = right;
+
+  while (root != NULL)
+  {
+    /**
+     * 1) A lower node goes to the left treap with its left side, and its right side still
+     * has to be split. The other way around for the rest of nodes
+     */
+    if (root->data < key)
+    {
+      *left_slot = root;
+      left_slot = &root->right;
+      root = root->right;
+    }
+    else
+    {
+      *right_slot = root;
+      right_slot = &root->left;
+      root = root->left;
+    }
+  }
+
+  *left_slot = NULL;
+  *right_slot = NULL;
+}
+
+/**
+ * @brief joins two treaps
+ *
+ * @param left Treap with the lower values
+ * @param right Treap with the greater values
+ *
+ * @returns root of the joined treap
+ *
+ * Every value of left must be lower or equal than every value of right. The right spine of
+ * left and the left spine of right are merged by priority, so this function runs in O(log n)
+ */
+TreapNode *join_treap(TreapNode *left, TreapNode *right)
+{
+  TreapNode *result = NULL;
+  TreapNode **slot = &result;
+
+  while (left != NULL && right != NULL)
+  {
+    if (left->priority >= right->priority)
+    {
+      *slot = left;
+      slot = &left->right;
+      left = left->right;
+    }
+    else
+    {
+      *slot = right;
+      slot = &right->left;
+      right = right->left;
+    }
+  }
+
+  *slot = (left != NULL) ? left : right;
+
+  return result;
+}
+
+/**
+ * @brief orders two nodes that may store the same value
+ *
+ * @param first first node
+ * @param second second node
+ *
+ * @returns 1 if first goes before second in the inorder route, otherwise 0
+ *
+ * Copies of a value are ordered by a second hash of their priority. It doesn't follow the
+ * heap order, so copies spread over both sides like distinct values instead of chaining
+ */
+static int treap_node_goes_before(const TreapNode *first, const TreapNode *second)
+{
+  if (first->data != second->data)
+  {
+    return first->data < second->data;
+  }
+
+  unsigned int first_rank = first->priority * 0x9e3779b1u;
+  unsigned int second_rank = second->priority * 0x9e3779b1u;
+
+  first_rank ^= first_rank >> 15;
+  second_rank ^= second_rank >> 15;
+
+  return first_rank < second_rank;
+}
+
+/**
+ * @brief splits a treap around a node that isn't in it yet
+ *
+ * @param root Treap root
+ * @param pivot node that will take the place of the split
+ * @param left variable where the nodes that go before pivot are stored
+ * @param right variable where the rest of nodes are stored
+ *
+ * Same walk as split_treap, but copies of the pivot value can go to both sides
+ */
+static void split_treap_around_node(TreapNode *root, const TreapNode *pivot, TreapNode **left, TreapNode **right)
+{
+  TreapNode **left_slot = left;
+  TreapNode **right_slot = right;
+
+  while (root != NULL)
+  {
+    if (treap_node_goes_before(root, pivot))
+    {
+      *left_slot = root;
+      left_slot = &root->right;
+      root = root->right;
+    }
+    else
+    {
+      *right_slot = root;
+      right_slot = &root->left;
+      root = root->left;
+    }
+  }
+
+  *left_slot = NULL;
+  *right_slot = NULL;
+}
+
+/**
+ * @brief creates a new node into a treap
+ *
+ * @param root A pointer to pointer of the treap root
+ * @param data value of the new node
+ *
+ * @returns amount of created nodes
+ *
+ * The walk goes down like insert_binary_tree_node until it finds a node with a lower
+ * priority. That subtree is split around the new node and both parts become its children.
+ * Copies of a value are ordered by treap_node_goes_before, so they can go to both sides
+ *
+ * Special cases:
+ *
+ * 1. If given pointer to pointer is null or the node can't be allocated, then this function
+ * will return 0
+ */
+int insert_treap_node(TreapNode **root, int data)
+{
+  if (root == NULL)
+  {
+    return 0;
+  }
+
+  TreapNode *new_node = create_treap_node(data);
+
+  if (new_node == NULL)
+  {
+    return 0;
+  }
+
+  TreapNode **slot = root;
+
+  while (*slot != NULL && (*slot)->priority >= new_node->priority)
+  {
+    slot = treap_node_goes_before(*slot, new_node) ? &(*slot)->right : &(*slot)->left;
+  }
+
+  split_treap_around_node(*slot, new_node, &new_node->left, &new_node->right);
+  *slot = new_node;
+
+  return 1;
+}
+
+/**
+ * @brief deletes a node from a treap
+ *
+ * @param root A pointer to pointer of the treap root
+ * @param data value to delete
+ *
+ * @returns amount of deleted nodes
+ *
+ * The children of the deleted node are joined and take its place
+ */
+int delete_treap_node(TreapNode **root, int data)
+{
+  if (root == NULL)
+  {
+    return 0;
+  }
+
+  TreapNode **slot = root;
+
+  while (*slot != NULL && (*slot)->data != data)
+  {
+    slot = (data > (*slot)->data) ? &(*slot)->right : &(*slot)->left;
+  }
+
+  if (*slot == NULL)
+  {
+    return 0;
+  }
+
+  TreapNode *deleted_node = *slot;
+  *slot = join_treap(deleted_node->left, deleted_node->right);
+  free(deleted_node);
+
+  return 1;
+}
+
+/**
+ * @brief searches a node by its value
+ *
+ * @param root Treap root
+ * @param data value to search
+ *
+ * @returns found node, or NULL if the value isn't in the treap
+ */
+TreapNode *search_treap_node(TreapNode *root, int data)
+{
+  TreapNode *current_node = root;
+
+  while (current_node != NULL)
+  {
+    if (data == current_node->data)
+    {
+      return current_node;
+    }
+
+    current_node = (data > current_node->data) ? current_node->right : current_node->left;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief frees every node of a treap
+ *
+ * @param root A pointer to pointer of the treap root
+ *
+ * @returns amount of freed nodes
+ *
+ * Left children are rotated to the right before freeing, so no stack is needed
+ */
+int free_treap(TreapNode **root)
+{
+  if (root == NULL)
+  {
+    return 0;
+  }
+
+  int freed_nodes = 0;
+  TreapNode *current_node = *root;
+
+  while (current_node != NULL)
+  {
+    if (current_node->left != NULL)
+    {
+      TreapNode *left_node = current_node->left;
+      current_node->left = left_node->right;
+      left_node->right = current_node;
+      current_node = left_node;
+      continue;
+    }
+
+    TreapNode *next_node = current_node->right;
+    free(current_node);
+    freed_nodes++;
+    current_node = next_node;
+  }
+
+  *root = NULL;
+
+  return freed_nodes;
+}
+
+static int compare_treap_values(const void *first, const void *second)
+{
+  int a = *(const int *)first;
+  int b = *(const int *)second;
+
+  return (a > b) - (a < b);
+}
+
+// Work of one shard of a bulk operation
+typedef struct TreapShard
+{
+  TreapNode *root;
+  const int *values;
+  int count;
+  int forks;
+  int insert;
+  int affected_nodes;
+} TreapShard;
+
+static void *process_treap_shard(void *argument);
+
+/**
+ * @brief applies a bulk operation over a shard, forking while there are threads left
+ *
+ * @param shard shard with its treap and its sorted values
+ *
+ * The values are cut at a pivot, the treap is split by the same pivot, and both halves are
+ * processed at the same time: the left one by a new thread and the right one by the current
+ * thread. Every value of a half can only touch the nodes of the same half, so the halves
+ * never share a node and can be joined back in O(log n)
+ */
+static void run_treap_shard(TreapShard *shard)
+{
+  /**
+   * 1) The pivot is the first copy of the middle value, so all the copies of a value end in
+   * the right half, the same half that split_treap gives them
+   */
+  int middle = shard->count / 2;
+
+  while (middle > 0 && shard->values[middle - 1] == shard->values[middle])
+  {
+    middle--;
+  }
+
+  if (shard->forks > 0 && shard->count >= 2 * TREAP_MIN_SHARD && middle > 0)
+  {
+    TreapShard left = {NULL, shard->values, middle, shard->forks - 1, shard->insert, 0};
+    TreapShard right = {NULL, shard->values + middle, shard->count - middle, shard->forks - 1, shard->insert, 0};
+
+    split_treap(shard->root, shard->values[middle], &left.root, &right.root);
+
+    /**
+     * 2) If a thread can't be created, the left half is processed by this thread too
+     */
+    pthread_t thread;
+    int forked = pthread_create(&thread, NULL, process_treap_shard, &left) == 0;
+
+    run_treap_shard(&right);
+
+    if (forked)
+    {
+      pthread_join(thread, NULL);
+    }
+    else
+    {
+      run_treap_shard(&left);
+    }
+
+    shard->root = join_treap(left.root, right.root);
+    shard->affected_nodes = left.affected_nodes + right.affected_nodes;
+
+    return;
+  }
+
+  /**
+   * 3) Small shards are processed one value at a time
+   */
+  for (int i = 0; i < shard->count; i++)
+  {
+    if (shard->insert)
+    {
+      shard->affected_nodes += insert_treap_node(&shard->root, shard->values[i]);
+    }
+    else
+    {
+      shard->affected_nodes += delete_treap_node(&shard->root, shard->values[i]);
+    }
+  }
+}
+
+static void *process_treap_shard(void *argument)
+{
+  run_treap_shard((TreapShard *)argument);
+
+  return NULL;
+}
+
+/**
+ * @brief applies a bulk insert or delete
+ *
+ * @param root A pointer to pointer of the treap root
+ * @param values values to insert or delete
+ * @param count amount of values
+ * @param threads maximum amount of threads working at the same time
+ * @param insert 1 to insert the values, 0 to delete them
+ *
+ * @returns amount of affected nodes, or -1 if memory can't be allocated
+ */
+static int apply_bulk_treap_operation(TreapNode **root, const int *values, int count, int threads, int insert)
+{
+  if (root == NULL || values == NULL || count <= 0)
+  {
+    return 0;
+  }
+
+  /**
+   * 1) Sorted values can be cut in ranges that match the split of the treap
+   */
+  int *sorted = (int *)malloc(sizeof(int) * count);
+
+  if (sorted == NULL)
+  {
+    return -1;
+  }
+
+  memcpy(sorted, values, sizeof(int) * count);
+  qsort(sorted, count, sizeof(int), compare_treap_values);
+
+  /**
+   * 2) Every fork doubles the threads, so log2(threads) levels of forks are used
+   */
+  int forks = 0;
+
+  while ((1 << (forks + 1)) <= threads)
+  {
+    forks++;
+  }
+
+  TreapShard shard = {*root, sorted, count, forks, insert, 0};
+  run_treap_shard(&shard);
+
+  *root = shard.root;
+  free(sorted);
+
+  return shard.affected_nodes;
+}
+
+/**
+ * @brief inserts several values into a treap using several threads
+ *
+ * @param root A pointer to pointer of the treap root
+ * @param values values to insert
+ * @param count amount of values
+ * @param threads maximum amount of threads working at the same time
+ *
+ * @returns amount of created nodes, or -1 if memory can't be allocated
+ *
+ * The treap is split into one shard per thread with split_treap, every thread inserts the
+ * values of its key range, and the shards are joined back with join_treap. Splits and joins
+ * cost O(log n), so the only linear work is the insertion itself
+ */
+int bulk_insert_treap(TreapNode **root, const int *values, int count, int threads)
+{
+  return apply_bulk_treap_operation(root, values, count, threads, 1);
+}
+
+/**
+ * @brief deletes several values from a treap using several threads
+ *
+ * @param root A pointer to pointer of the treap root
+ * @param values values to delete, every value deletes one node
+ * @param count amount of values
+ * @param threads maximum amount of threads working at the same time
+ *
+ * @returns amount of deleted nodes, or -1 if memory can't be allocated
+ *
+ * This function shards the treap the same way as bulk_insert_treap
+ */
+int bulk_delete_treap(TreapNode **root, const int *values, int count, int threads)
+{
+  return apply_bulk_treap_operation(root, values, count, threads, 0);
+}